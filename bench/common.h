@@ -0,0 +1,232 @@
+/**
+ * Helpers shared by the benchmarks and by the super-linear input check:
+ * loading the input files, timing, editing a text the way an editor does,
+ * and summarizing latencies.
+ *
+ * Each program is a single translation unit, so everything here is static.
+ * Define BENCH_NAME before including this file to change the prefix of the
+ * messages it prints.
+ */
+
+#ifndef TREE_SITTER_BASH_BENCH_COMMON_H_
+#define TREE_SITTER_BASH_BENCH_COMMON_H_
+
+#include "tree_sitter/api.h"
+
+#include <errno.h>
+#include <ftw.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef BENCH_NAME
+#define BENCH_NAME "bench"
+#endif
+
+typedef struct {
+    char *path;
+    char *contents;
+    uint32_t length;
+} SourceFile;
+
+typedef struct {
+    SourceFile *contents;
+    size_t size;
+    size_t capacity;
+} SourceFiles;
+
+static inline double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * Adds a copy of `length` bytes of `contents` to `files`, with a trailing NUL
+ * that isn't counted in its length.
+ */
+static inline void add_source(SourceFiles *files, const char *path, const char *contents, uint32_t length) {
+    if (files->size == files->capacity) {
+        files->capacity = files->capacity ? files->capacity * 2 : 64;
+        files->contents = realloc(files->contents, files->capacity * sizeof(SourceFile));
+    }
+    SourceFile *file = &files->contents[files->size++];
+    file->path = strdup(path);
+    file->contents = malloc((size_t)length + 1);
+    memcpy(file->contents, contents, length);
+    file->contents[length] = '\0';
+    file->length = length;
+}
+
+static inline void delete_sources(SourceFiles *files) {
+    for (size_t i = 0; i < files->size; i++) {
+        free(files->contents[i].path);
+        free(files->contents[i].contents);
+    }
+    free(files->contents);
+    *files = (SourceFiles){0};
+}
+
+/**
+ * Returns the contents of the file at `path`, with a trailing NUL that isn't
+ * counted in `length`, or NULL if it can't be read.
+ */
+static inline char *read_file(const char *path, uint32_t *length) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        return NULL;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (size < 0 || size > UINT32_MAX) {
+        fclose(fp);
+        return NULL;
+    }
+
+    char *contents = malloc((size_t)size + 1);
+    *length = (uint32_t)fread(contents, 1, (size_t)size, fp);
+    contents[*length] = '\0';
+    fclose(fp);
+    return contents;
+}
+
+static inline bool is_line_of(const char *line, const char *end, char c) {
+    if (end - line < 3) {
+        return false;
+    }
+    for (const char *p = line; p < end; p++) {
+        if (*p != c) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Adds the input of each test in a corpus file: the text between the second
+ * `===` line of its header and the `---` line that starts its expected tree.
+ */
+static inline void add_corpus_tests(SourceFiles *files, const char *path, const char *text, uint32_t length) {
+    const char *end = text + length;
+    const char *input = NULL;
+    unsigned header_lines = 0;
+    unsigned test = 0;
+    for (const char *line = text; line < end;) {
+        const char *line_end = memchr(line, '\n', (size_t)(end - line));
+        line_end = line_end ? line_end : end;
+        if (is_line_of(line, line_end, '=')) {
+            header_lines++;
+            if (header_lines % 2 == 0) {
+                input = line_end < end ? line_end + 1 : end;
+            }
+        } else if (input && is_line_of(line, line_end, '-')) {
+            char name[4096];
+            snprintf(name, sizeof(name), "%s:%u", path, ++test);
+            add_source(files, name, input, (uint32_t)(line - input));
+            input = NULL;
+        }
+        line = line_end + 1;
+    }
+}
+
+// nftw takes no context argument, so add_sources passes its own through these.
+static SourceFiles *sources_being_added;
+static bool split_corpus_files;
+
+static inline int add_file(const char *path, const struct stat *sb, int type, struct FTW *ftwbuf) {
+    (void)sb;
+    (void)ftwbuf;
+    if (type != FTW_F) {
+        return 0;
+    }
+
+    uint32_t length;
+    char *contents = read_file(path, &length);
+    if (!contents) {
+        fprintf(stderr, BENCH_NAME ": cannot read %s: %s\n", path, strerror(errno));
+        return 0;
+    }
+    if (split_corpus_files && length > 0 && contents[0] == '=') {
+        add_corpus_tests(sources_being_added, path, contents, length);
+    } else {
+        add_source(sources_being_added, path, contents, length);
+    }
+    free(contents);
+    return 0;
+}
+
+/**
+ * Adds every file under `path` to `files`. With `split_corpus`, a corpus file
+ * adds the input of each of its tests instead of its own text. Returns false
+ * if `path` can't be walked.
+ */
+static inline bool add_sources(SourceFiles *files, const char *path, bool split_corpus) {
+    sources_being_added = files;
+    split_corpus_files = split_corpus;
+    if (nftw(path, add_file, 16, FTW_PHYS) != 0) {
+        fprintf(stderr, BENCH_NAME ": cannot walk %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+static inline TSPoint point_at(const char *text, uint32_t offset) {
+    TSPoint point = {0, 0};
+    for (uint32_t i = 0; i < offset; i++) {
+        if (text[i] == '\n') {
+            point.row++;
+            point.column = 0;
+        } else {
+            point.column++;
+        }
+    }
+    return point;
+}
+
+/**
+ * Replaces `old_length` bytes at `offset` of `*text` with `new_length` bytes
+ * of `new_text`, reallocating it, and returns the edit to apply to its tree.
+ */
+static inline TSInputEdit edit_text(char **text, uint32_t *length, uint32_t offset, uint32_t old_length,
+                                    const char *new_text, uint32_t new_length) {
+    TSInputEdit edit;
+    edit.start_byte = offset;
+    edit.old_end_byte = offset + old_length;
+    edit.new_end_byte = offset + new_length;
+    edit.start_point = point_at(*text, offset);
+    edit.old_end_point = point_at(*text, offset + old_length);
+
+    char *edited = malloc(*length - old_length + new_length + 1);
+    memcpy(edited, *text, offset);
+    memcpy(&edited[offset], new_text, new_length);
+    memcpy(&edited[offset + new_length], &(*text)[offset + old_length], *length - offset - old_length + 1);
+    free(*text);
+    *text = edited;
+    *length = *length - old_length + new_length;
+    edit.new_end_point = point_at(*text, offset + new_length);
+    return edit;
+}
+
+static inline int compare_doubles(const void *a, const void *b) {
+    double lhs = *(const double *)a;
+    double rhs = *(const double *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static inline double percentile(const double *sorted, size_t count, double p) {
+    if (count == 0) {
+        return 0;
+    }
+    size_t index = (size_t)(p * (double)count + 0.5);
+    if (index > 0) {
+        index--;
+    }
+    return sorted[index < count ? index : count - 1];
+}
+
+#endif // TREE_SITTER_BASH_BENCH_COMMON_H_
@@ -0,0 +1,132 @@
+/**
+ * Incremental reparse benchmark for edits inside a large heredoc.
+ *
+ * Builds a script whose body is a heredoc of each of the given sizes (default:
+ * 64 KB, 1 MB and 5 MB), then types and deletes one character at a time at
+ * positions spread over the heredoc, reparsing after each keystroke. Prints the
+ * results as a JSON object on stdout.
+ *
+ *     bench/edit [-e edits] [size...]
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "common.h"
+#include "tree_sitter/api.h"
+#include "tree_sitter/tree-sitter-bash.h"
+
+static uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t next_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return (uint32_t)random_state;
+}
+
+/**
+ * Returns a script with a heredoc of about `body_size` bytes of configuration
+ * text, and sets `body_start` and `body_end` to the byte range of the body.
+ */
+static char *build_script(uint32_t body_size, uint32_t *length, uint32_t *body_start, uint32_t *body_end) {
+    static const char *const words[] = {"name", "value", "enabled", "true", "false", "port", "8080",
+                                        "- item", "host:", "localhost", "# comment", "timeout", "30s"};
+    const char *head = "cat <<EOF > config.yaml\n";
+    const char *tail = "EOF\necho done\n";
+
+    char *script = malloc(strlen(head) + body_size + 256 + strlen(tail) + 1);
+    uint32_t size = (uint32_t)sprintf(script, "%s", head);
+    *body_start = size;
+    while (size - *body_start < body_size) {
+        size += (uint32_t)sprintf(&script[size], "%*s", (int)(next_random() % 4) * 2, "");
+        unsigned word_count = 1 + next_random() % 8;
+        for (unsigned i = 0; i < word_count; i++) {
+            size += (uint32_t)sprintf(&script[size], "%s%s", i ? " " : "",
+                                      words[next_random() % (sizeof(words) / sizeof(words[0]))]);
+        }
+        script[size++] = '\n';
+    }
+    *body_end = size;
+    size += (uint32_t)sprintf(&script[size], "%s", tail);
+    *length = size;
+    return script;
+}
+
+/**
+ * Applies an edit that replaces `old_length` bytes at `offset` with
+ * `new_text`, and reparses. Returns the time the reparse took.
+ */
+static double apply_edit(TSParser *parser, TSTree **tree, char **text, uint32_t *length, uint32_t offset,
+                         uint32_t old_length, const char *new_text) {
+    TSInputEdit edit = edit_text(text, length, offset, old_length, new_text, (uint32_t)strlen(new_text));
+    ts_tree_edit(*tree, &edit);
+    double start = now();
+    TSTree *new_tree = ts_parser_parse_string(parser, *tree, *text, *length);
+    double elapsed = now() - start;
+    ts_tree_delete(*tree);
+    *tree = new_tree;
+    return elapsed;
+}
+
+static void run(TSParser *parser, uint32_t body_size, unsigned edit_count, bool last) {
+    uint32_t length;
+    uint32_t body_start;
+    uint32_t body_end;
+    char *text = build_script(body_size, &length, &body_start, &body_end);
+
+    double start = now();
+    TSTree *tree = ts_parser_parse_string(parser, NULL, text, length);
+    double full_parse = now() - start;
+    bool has_error = ts_node_has_error(ts_tree_root_node(tree));
+
+    // Each edit types a character and then deletes it again, so that every
+    // reparse sees the same text around the edit.
+    double *latencies = malloc(2 * edit_count * sizeof(double));
+    for (unsigned i = 0; i < edit_count; i++) {
+        uint32_t offset = body_start + next_random() % (body_end - body_start);
+        latencies[2 * i] = apply_edit(parser, &tree, &text, &length, offset, 0, "x");
+        latencies[2 * i + 1] = apply_edit(parser, &tree, &text, &length, offset, 1, "");
+    }
+    has_error = has_error || ts_node_has_error(ts_tree_root_node(tree));
+    qsort(latencies, 2 * edit_count, sizeof(double), compare_doubles);
+
+    printf("    {\"heredoc_bytes\": %u, \"edits\": %u, \"has_error\": %s, \"full_parse_ms\": %.3f, ", body_end - body_start,
+           2 * edit_count, has_error ? "true" : "false", full_parse * 1e3);
+    printf("\"reparse_ms\": {\"p50\": %.4f, \"p99\": %.4f, \"max\": %.4f}}%s\n",
+           percentile(latencies, 2 * edit_count, 0.50) * 1e3, percentile(latencies, 2 * edit_count, 0.99) * 1e3,
+           latencies[2 * edit_count - 1] * 1e3, last ? "" : ",");
+
+    ts_tree_delete(tree);
+    free(latencies);
+    free(text);
+}
+
+int main(int argc, char **argv) {
+    static const uint32_t default_sizes[] = {64 * 1024, 1024 * 1024, 5 * 1024 * 1024};
+    unsigned edit_count = 100;
+    int first_size = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-e") == 0) {
+        edit_count = (unsigned)strtoul(argv[2], NULL, 10);
+        edit_count = edit_count ? edit_count : 1;
+        first_size = 3;
+    }
+
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_bash());
+
+    printf("{\n  \"heredocs\": [\n");
+    if (first_size >= argc) {
+        size_t count = sizeof(default_sizes) / sizeof(default_sizes[0]);
+        for (size_t i = 0; i < count; i++) {
+            run(parser, default_sizes[i], edit_count, i + 1 == count);
+        }
+    }
+    for (int i = first_size; i < argc; i++) {
+        run(parser, (uint32_t)strtoul(argv[i], NULL, 10), edit_count, i + 1 == argc);
+    }
+    printf("  ]\n}\n");
+
+    ts_parser_delete(parser);
+    return 0;
+}
@@ -0,0 +1,706 @@
+/**
+ * Deterministic generator of synthetic Bash scripts.
+ *
+ * Writes a script of about the given size (default: 1M; suffixes K, M and G
+ * are powers of 1024) to stdout, so that the benchmarks and fuzzers can run on
+ * inputs of any size without fetching a corpus. The same options always give
+ * the same script.
+ *
+ * The script is a sequence of statements whose constructs are picked with the
+ * weights of a mix (`-m`, default: `default`), which single weights can
+ * override (`-w construct=weight`). The `configure` mix writes feature checks
+ * in the style of an autoconf `configure` script. `-d` sets how deeply command
+ * substitutions are nested, and `-s` picks another script.
+ *
+ *     bench/generate [-m mix] [-w construct=weight]... [-d depth] [-s seed] [size]
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    CONSTRUCT_COMMAND,
+    CONSTRUCT_HEREDOC,
+    CONSTRUCT_EXPANSION,
+    CONSTRUCT_REGEX,
+    CONSTRUCT_EXTGLOB,
+    CONSTRUCT_CASE,
+    CONSTRUCT_ARITHMETIC,
+    CONSTRUCT_SUBSTITUTION,
+    CONSTRUCT_CONTROL,
+    CONSTRUCT_FUNCTION,
+    CONSTRUCT_CHECK,
+    CONSTRUCT_COUNT,
+} Construct;
+
+static const char *const CONSTRUCT_NAMES[CONSTRUCT_COUNT] = {
+    [CONSTRUCT_COMMAND] = "command",
+    [CONSTRUCT_HEREDOC] = "heredoc",
+    [CONSTRUCT_EXPANSION] = "expansion",
+    [CONSTRUCT_REGEX] = "regex",
+    [CONSTRUCT_EXTGLOB] = "extglob",
+    [CONSTRUCT_CASE] = "case",
+    [CONSTRUCT_ARITHMETIC] = "arithmetic",
+    [CONSTRUCT_SUBSTITUTION] = "substitution",
+    [CONSTRUCT_CONTROL] = "control",
+    [CONSTRUCT_FUNCTION] = "function",
+    [CONSTRUCT_CHECK] = "check",
+};
+
+typedef struct {
+    const char *name;
+    unsigned weights[CONSTRUCT_COUNT];
+} Mix;
+
+static const Mix MIXES[] = {
+    {"default", {[CONSTRUCT_COMMAND] = 30, [CONSTRUCT_HEREDOC] = 6, [CONSTRUCT_EXPANSION] = 12, [CONSTRUCT_REGEX] = 4,
+                 [CONSTRUCT_EXTGLOB] = 3, [CONSTRUCT_CASE] = 5, [CONSTRUCT_ARITHMETIC] = 8,
+                 [CONSTRUCT_SUBSTITUTION] = 8, [CONSTRUCT_CONTROL] = 14, [CONSTRUCT_FUNCTION] = 4}},
+    {"configure", {[CONSTRUCT_COMMAND] = 10, [CONSTRUCT_HEREDOC] = 4, [CONSTRUCT_EXPANSION] = 6, [CONSTRUCT_CASE] = 6,
+                   [CONSTRUCT_SUBSTITUTION] = 2, [CONSTRUCT_CONTROL] = 6, [CONSTRUCT_FUNCTION] = 1,
+                   [CONSTRUCT_CHECK] = 30}},
+    {"plain", {[CONSTRUCT_COMMAND] = 60, [CONSTRUCT_CONTROL] = 15, [CONSTRUCT_FUNCTION] = 3}},
+};
+
+#define MIX_COUNT (sizeof(MIXES) / sizeof(MIXES[0]))
+
+// Statements are only nested this deep, so that the script stays mostly flat
+// like real ones.
+#define MAX_NESTING 3
+
+static unsigned weights[CONSTRUCT_COUNT];
+static unsigned weight_total;
+static unsigned substitution_depth = 3;
+
+static uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t next_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return (uint32_t)random_state;
+}
+
+static uint32_t random_below(uint32_t bound) { return next_random() % bound; }
+
+static bool one_in(uint32_t n) { return random_below(n) == 0; }
+
+#define PICK(array) (array)[random_below(sizeof(array) / sizeof((array)[0]))]
+
+static const char *const WORDS[] = {"name",   "value", "path",  "file",   "dir",    "prefix", "target", "config",
+                                    "output", "input", "count", "status", "result", "line",   "version"};
+static const char *const COMMANDS[] = {"echo", "printf", "grep",  "sed", "awk",   "cut",   "sort",  "mkdir",
+                                       "rm",   "cp",     "chmod", "tr",  "touch", "uname", "basename"};
+static const char *const FLAGS[] = {"-f", "-q", "-n", "-v", "-p", "-r", "--quiet", "--force", "-e", "-1"};
+
+static uint64_t written;
+static unsigned indent;
+static unsigned serial;
+
+static void emit(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = vprintf(format, args);
+    va_end(args);
+    written += length > 0 ? (uint64_t)length : 0;
+}
+
+static void start_line(void) { emit("%*s", (int)indent * 2, ""); }
+
+static void emit_word(void) { emit("%s", PICK(WORDS)); }
+
+static void emit_variable(void) {
+    static const char *const forms[] = {"$%s", "${%s}", "\"$%s\"", "\"${%s}\""};
+    emit(PICK(forms), PICK(WORDS));
+}
+
+static void emit_argument(void) {
+    switch (random_below(6)) {
+        case 0:
+            emit("%s", PICK(FLAGS));
+            break;
+        case 1:
+            emit_variable();
+            break;
+        case 2:
+            emit("\"%s %s\"", PICK(WORDS), PICK(WORDS));
+            break;
+        case 3:
+            emit("'%s'", PICK(WORDS));
+            break;
+        case 4:
+            emit("\"$%s/%s.txt\"", PICK(WORDS), PICK(WORDS));
+            break;
+        default:
+            emit_word();
+            break;
+    }
+}
+
+static void emit_simple_command(void) {
+    emit("%s", PICK(COMMANDS));
+    for (unsigned i = random_below(4); i > 0; i--) {
+        emit(" ");
+        emit_argument();
+    }
+}
+
+static void emit_substitution(unsigned depth) {
+    static const char *const commands[] = {"basename", "dirname", "echo", "printf '%s\\n'", "cat"};
+    emit("$(%s ", PICK(commands));
+    if (depth > 1) {
+        emit("\"");
+        emit_substitution(depth - 1);
+        emit("\"");
+    } else {
+        emit_variable();
+    }
+    emit(")");
+}
+
+static void emit_expansion(void) {
+    static const char *const forms[] = {"${%s:-default}", "${%s#*/}",   "${%s%%%%.*}", "${%s//-/_}",  "${#%s}",
+                                        "${%s:1:3}",      "${%s^^}",    "${%s:+set}",  "${%s[@]}",    "${!%s}",
+                                        "${%s:=x}",       "${%s%%/*}",  "${%s/#./}",   "${%s,}",      "${%s@Q}"};
+    if (one_in(6)) {
+        emit("${%s:-${%s:-fallback}}", PICK(WORDS), PICK(WORDS));
+    } else {
+        emit(PICK(forms), PICK(WORDS));
+    }
+}
+
+static void emit_arithmetic_expression(unsigned depth) {
+    static const char *const operators[] = {"+", "-", "*", "/", "%", "<<", ">>", "&", "|", "^", "**", "<", "==", "&&"};
+    if (depth == 0 || one_in(3)) {
+        if (one_in(2)) {
+            emit("%s", PICK(WORDS));
+        } else {
+            emit("%u", random_below(64));
+        }
+        return;
+    }
+    if (one_in(5)) {
+        emit("(");
+        emit_arithmetic_expression(depth - 1);
+        emit(")");
+        return;
+    }
+    if (one_in(8)) {
+        emit_arithmetic_expression(depth - 1);
+        emit(" ? ");
+        emit_arithmetic_expression(depth - 1);
+        emit(" : ");
+        emit_arithmetic_expression(depth - 1);
+        return;
+    }
+    emit_arithmetic_expression(depth - 1);
+    emit(" %s ", PICK(operators));
+    emit_arithmetic_expression(depth - 1);
+}
+
+static void statement(unsigned depth);
+
+static void body(unsigned depth) {
+    indent++;
+    for (unsigned i = 1 + random_below(3); i > 0; i--) {
+        statement(depth + 1);
+    }
+    indent--;
+}
+
+static void command(void) {
+    start_line();
+    switch (random_below(6)) {
+        case 0:
+            emit("%s=", PICK(WORDS));
+            emit_argument();
+            break;
+        case 1:
+            emit_simple_command();
+            emit(" | ");
+            emit_simple_command();
+            break;
+        case 2:
+            emit_simple_command();
+            emit(" >\"$%s\" 2>&1", PICK(WORDS));
+            break;
+        case 3:
+            emit_simple_command();
+            emit(" || return 1");
+            break;
+        case 4:
+            // A comment on its own isn't a statement, so a command follows.
+            emit("# %s the %s before the %s\n", PICK(COMMANDS), PICK(WORDS), PICK(WORDS));
+            start_line();
+            emit_simple_command();
+            break;
+        default:
+            emit_simple_command();
+            break;
+    }
+    emit("\n");
+}
+
+static void heredoc_line(bool expand) {
+    start_line();
+    emit("%s: ", PICK(WORDS));
+    if (expand && one_in(2)) {
+        emit_variable();
+    } else if (expand && one_in(3)) {
+        emit_expansion();
+    } else {
+        emit("%s %s", PICK(WORDS), PICK(WORDS));
+    }
+    emit("\n");
+}
+
+static void heredoc(void) {
+    unsigned id = serial++;
+    unsigned lines = 1 + random_below(8);
+    switch (random_below(4)) {
+        case 0:
+            // Quoted, so that the body is raw text, and indented with tabs,
+            // which `<<-` strips.
+            start_line();
+            emit("cat <<-'END%u'\n", id);
+            for (unsigned i = 0; i < lines; i++) {
+                emit("\t%s $%s ${%s} $(%s)\n", PICK(WORDS), PICK(WORDS), PICK(WORDS), PICK(COMMANDS));
+            }
+            emit("\tEND%u\n", id);
+            break;
+        case 1:
+            // A heredoc in a command substitution in a heredoc.
+            start_line();
+            emit("cat <<OUTER%u\n", id);
+            heredoc_line(true);
+            emit("$(cat <<INNER%u\n", id);
+            for (unsigned i = 0; i < lines; i++) {
+                heredoc_line(true);
+            }
+            emit("INNER%u\n)\n", id);
+            heredoc_line(true);
+            emit("OUTER%u\n", id);
+            break;
+        case 2:
+            // Two heredocs started on the same line.
+            start_line();
+            emit("cat <<FIRST%u; cat <<SECOND%u >\"$%s\"\n", id, id, PICK(WORDS));
+            heredoc_line(true);
+            emit("FIRST%u\n", id);
+            for (unsigned i = 0; i < lines; i++) {
+                heredoc_line(true);
+            }
+            emit("SECOND%u\n", id);
+            break;
+        default:
+            start_line();
+            emit("cat >\"$%s\" <<EOF\n", PICK(WORDS));
+            for (unsigned i = 0; i < lines; i++) {
+                heredoc_line(true);
+            }
+            emit("EOF\n");
+            break;
+    }
+}
+
+static void expansion(void) {
+    start_line();
+    emit("%s=\"", PICK(WORDS));
+    emit_expansion();
+    if (one_in(2)) {
+        emit("/");
+        emit_expansion();
+    }
+    emit("\"\n");
+}
+
+static void regex(unsigned depth) {
+    static const char *const regexes[] = {
+        "^[0-9]+$", "^([a-z]+)-([0-9]+)$", "\\.tar\\.(gz|xz|bz2)$", "^(foo|bar)[._-]?v?[0-9]+(\\.[0-9]+)*$",
+        "[[:space:]]+$", "^[[:space:]]*#", "^[^=]+=(.*)$", "^--?[a-zA-Z][a-zA-Z-]*$"};
+    start_line();
+    emit("if [[ $%s =~ %s ]]; then\n", PICK(WORDS), PICK(regexes));
+    indent++;
+    start_line();
+    emit("%s=\"${BASH_REMATCH[1]}\"\n", PICK(WORDS));
+    if (depth < MAX_NESTING) {
+        statement(depth + 1);
+    }
+    indent--;
+    start_line();
+    emit("fi\n");
+}
+
+static const char *const EXTGLOBS[] = {"@(*.c|*.h)", "!(*.o|*.a)", "+([0-9]).txt", "*([a-z])-*", "?(-)+([0-9])",
+                                       "@(yes|y|true|1)"};
+
+static void extglob(void) {
+    start_line();
+    switch (random_below(3)) {
+        case 0:
+            emit("for %s in %s; do\n", PICK(WORDS), PICK(EXTGLOBS));
+            indent++;
+            start_line();
+            emit_simple_command();
+            emit("\n");
+            indent--;
+            start_line();
+            emit("done\n");
+            break;
+        case 1:
+            emit("[[ $%s == %s ]] && ", PICK(WORDS), PICK(EXTGLOBS));
+            emit_simple_command();
+            emit("\n");
+            break;
+        default:
+            emit("rm -f %s\n", PICK(EXTGLOBS));
+            break;
+    }
+}
+
+static void case_statement(unsigned depth) {
+    static const char *const patterns[] = {"*.txt", "-h|--help", "[0-9]*", "yes|y", "''", "\"$prefix\"*", "-*"};
+    static const char *const terminators[] = {";;", ";;", ";;", ";&", ";;&"};
+    start_line();
+    emit("case ");
+    emit_variable();
+    emit(" in\n");
+    indent++;
+    for (unsigned i = 1 + random_below(4); i > 0; i--) {
+        start_line();
+        if (weights[CONSTRUCT_EXTGLOB] && one_in(3)) {
+            emit("%s)\n", PICK(EXTGLOBS));
+        } else {
+            emit("%s)\n", PICK(patterns));
+        }
+        if (depth < MAX_NESTING) {
+            body(depth);
+        }
+        indent++;
+        start_line();
+        emit("%s\n", PICK(terminators));
+        indent--;
+    }
+    start_line();
+    emit("*)\n");
+    indent++;
+    start_line();
+    emit(";;\n");
+    indent--;
+    indent--;
+    start_line();
+    emit("esac\n");
+}
+
+static void arithmetic(unsigned depth) {
+    start_line();
+    switch (random_below(4)) {
+        case 0:
+            emit("(( %s += ", PICK(WORDS));
+            emit_arithmetic_expression(3);
+            emit(" ))\n");
+            break;
+        case 1:
+            emit("%s=$(( ", PICK(WORDS));
+            emit_arithmetic_expression(4);
+            emit(" ))\n");
+            break;
+        case 2:
+            emit("for (( i = 0; i < %s; i++ )); do\n", PICK(WORDS));
+            if (depth < MAX_NESTING) {
+                body(depth);
+            } else {
+                indent++;
+                start_line();
+                emit(":\n");
+                indent--;
+            }
+            start_line();
+            emit("done\n");
+            break;
+        default:
+            emit("%s[i+1]=$(( %s[i] << 1 ))\n", PICK(WORDS), PICK(WORDS));
+            break;
+    }
+}
+
+static void substitution(void) {
+    start_line();
+    emit("%s=\"", PICK(WORDS));
+    emit_substitution(1 + random_below(substitution_depth));
+    emit("\"\n");
+}
+
+static void control(unsigned depth) {
+    if (depth >= MAX_NESTING) {
+        command();
+        return;
+    }
+
+    start_line();
+    switch (random_below(5)) {
+        case 0:
+            emit("if [ -n ");
+            emit_variable();
+            emit(" ]; then\n");
+            body(depth);
+            if (one_in(2)) {
+                start_line();
+                emit("elif [ -f \"$%s\" ]; then\n", PICK(WORDS));
+                body(depth);
+            }
+            if (one_in(2)) {
+                start_line();
+                emit("else\n");
+                body(depth);
+            }
+            start_line();
+            emit("fi\n");
+            break;
+        case 1:
+            emit("for %s in ", PICK(WORDS));
+            emit_variable();
+            emit(" %s; do\n", PICK(WORDS));
+            body(depth);
+            start_line();
+            emit("done\n");
+            break;
+        case 2:
+            emit("while IFS= read -r %s; do\n", PICK(WORDS));
+            body(depth);
+            start_line();
+            emit("done <\"$%s\"\n", PICK(WORDS));
+            break;
+        case 3:
+            emit("{\n");
+            body(depth);
+            start_line();
+            emit("} >>\"$%s\"\n", PICK(WORDS));
+            break;
+        default:
+            emit("(\n");
+            body(depth);
+            start_line();
+            emit(")\n");
+            break;
+    }
+}
+
+static void function(unsigned depth) {
+    if (depth > 0) {
+        command();
+        return;
+    }
+
+    start_line();
+    emit("%s_%s_%u() {\n", PICK(WORDS), PICK(WORDS), serial++);
+    indent++;
+    start_line();
+    emit("local %s=\"$1\" %s\n", PICK(WORDS), PICK(WORDS));
+    indent--;
+    body(depth);
+    start_line();
+    emit("}\n\n");
+}
+
+// A feature check in the shape that autoconf writes them.
+static void check(void) {
+    static const char *const headers[] = {"stdlib", "string", "unistd", "fcntl", "sys/time", "locale", "wchar"};
+    const char *header = PICK(headers);
+    unsigned id = serial++;
+    emit("{ $as_echo \"$as_me:${as_lineno-$LINENO}: checking for %s_%u\" >&5\n", header, id);
+    emit("$as_echo_n \"checking for %s_%u... \" >&6; }\n", header, id);
+    emit("if ${ac_cv_header_%u+:} false; then :\n", id);
+    emit("  $as_echo_n \"(cached) \" >&6\n");
+    emit("else\n");
+    emit("  cat confdefs.h - <<_ACEOF >conftest.$ac_ext\n");
+    emit("/* end confdefs.h.  */\n");
+    emit("#include <%s.h>\n", header);
+    emit("int\nmain ()\n{\n\n  ;\n  return 0;\n}\n");
+    emit("_ACEOF\n");
+    emit("if ac_fn_c_try_compile \"$LINENO\"; then :\n");
+    emit("  ac_cv_header_%u=yes\n", id);
+    emit("else\n");
+    emit("  ac_cv_header_%u=no\n", id);
+    emit("fi\n");
+    emit("rm -f core conftest.err conftest.$ac_objext conftest.$ac_ext\n");
+    emit("fi\n");
+    emit("{ $as_echo \"$as_me:${as_lineno-$LINENO}: result: $ac_cv_header_%u\" >&5\n", id);
+    emit("$as_echo \"$ac_cv_header_%u\" >&6; }\n", id);
+    emit("if test \"x$ac_cv_header_%u\" = xyes; then :\n", id);
+    emit("  cat >>confdefs.h <<_ACEOF\n");
+    emit("#define HAVE_HEADER_%u 1\n", id);
+    emit("_ACEOF\n\n");
+    emit("fi\n\n");
+}
+
+static void statement(unsigned depth) {
+    uint32_t pick = random_below(weight_total);
+    Construct construct = 0;
+    while (pick >= weights[construct]) {
+        pick -= weights[construct];
+        construct++;
+    }
+
+    switch (construct) {
+        case CONSTRUCT_HEREDOC:
+            heredoc();
+            break;
+        case CONSTRUCT_EXPANSION:
+            expansion();
+            break;
+        case CONSTRUCT_REGEX:
+            regex(depth);
+            break;
+        case CONSTRUCT_EXTGLOB:
+            extglob();
+            break;
+        case CONSTRUCT_CASE:
+            case_statement(depth);
+            break;
+        case CONSTRUCT_ARITHMETIC:
+            arithmetic(depth);
+            break;
+        case CONSTRUCT_SUBSTITUTION:
+            substitution();
+            break;
+        case CONSTRUCT_CONTROL:
+            control(depth);
+            break;
+        case CONSTRUCT_FUNCTION:
+            function(depth);
+            break;
+        case CONSTRUCT_CHECK:
+            // The checks are top-level code and don't nest.
+            if (depth == 0 && indent == 0) {
+                check();
+            } else {
+                command();
+            }
+            break;
+        default:
+            command();
+            break;
+    }
+}
+
+static bool parse_size(const char *text, uint64_t *size) {
+    char *end;
+    unsigned long long value = strtoull(text, &end, 10);
+    switch (*end) {
+        case 'K':
+        case 'k':
+            value <<= 10;
+            end++;
+            break;
+        case 'M':
+        case 'm':
+            value <<= 20;
+            end++;
+            break;
+        case 'G':
+        case 'g':
+            value <<= 30;
+            end++;
+            break;
+        default:
+            break;
+    }
+    *size = value;
+    return end != text && *end == '\0';
+}
+
+static bool set_weight(const char *assignment) {
+    const char *equals = strchr(assignment, '=');
+    if (!equals) {
+        return false;
+    }
+    for (unsigned i = 0; i < CONSTRUCT_COUNT; i++) {
+        if (strlen(CONSTRUCT_NAMES[i]) == (size_t)(equals - assignment) &&
+            strncmp(CONSTRUCT_NAMES[i], assignment, (size_t)(equals - assignment)) == 0) {
+            weights[i] = (unsigned)strtoul(equals + 1, NULL, 10);
+            return true;
+        }
+    }
+    return false;
+}
+
+static int usage(void) {
+    fprintf(stderr, "usage: generate [-m mix] [-w construct=weight]... [-d depth] [-s seed] [size]\n");
+    fprintf(stderr, "mixes:");
+    for (size_t i = 0; i < MIX_COUNT; i++) {
+        fprintf(stderr, " %s", MIXES[i].name);
+    }
+    fprintf(stderr, "\nconstructs:");
+    for (unsigned i = 0; i < CONSTRUCT_COUNT; i++) {
+        fprintf(stderr, " %s", CONSTRUCT_NAMES[i]);
+    }
+    fprintf(stderr, "\n");
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    uint64_t size = 1 << 20;
+    const Mix *mix = &MIXES[0];
+    const char *overrides[CONSTRUCT_COUNT * 2];
+    unsigned override_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-') {
+            if (!parse_size(argv[i], &size)) {
+                return usage();
+            }
+        } else if (i + 1 >= argc) {
+            return usage();
+        } else if (strcmp(argv[i], "-m") == 0) {
+            const char *name = argv[++i];
+            mix = NULL;
+            for (size_t m = 0; m < MIX_COUNT && !mix; m++) {
+                mix = strcmp(MIXES[m].name, name) == 0 ? &MIXES[m] : NULL;
+            }
+            if (!mix) {
+                return usage();
+            }
+        } else if (strcmp(argv[i], "-w") == 0 && override_count < CONSTRUCT_COUNT * 2) {
+            overrides[override_count++] = argv[++i];
+        } else if (strcmp(argv[i], "-d") == 0) {
+            substitution_depth = (unsigned)strtoul(argv[++i], NULL, 10);
+            substitution_depth = substitution_depth ? substitution_depth : 1;
+        } else if (strcmp(argv[i], "-s") == 0) {
+            random_state ^= strtoull(argv[++i], NULL, 10) * 0xBF58476D1CE4E5B9ULL;
+            random_state = random_state ? random_state : 1;
+        } else {
+            return usage();
+        }
+    }
+
+    memcpy(weights, mix->weights, sizeof(weights));
+    for (unsigned i = 0; i < override_count; i++) {
+        if (!set_weight(overrides[i])) {
+            return usage();
+        }
+    }
+    for (unsigned i = 0; i < CONSTRUCT_COUNT; i++) {
+        weight_total += weights[i];
+    }
+    if (weight_total == 0) {
+        return usage();
+    }
+
+    static char buffer[1 << 16];
+    setvbuf(stdout, buffer, _IOFBF, sizeof(buffer));
+
+    emit("#!/bin/bash\n");
+    if (weights[CONSTRUCT_EXTGLOB]) {
+        emit("shopt -s extglob\n");
+    }
+    emit("\n");
+    while (written < size) {
+        statement(0);
+    }
+    return fflush(stdout) == 0 ? 0 : 1;
+}
@@ -0,0 +1,270 @@
+/**
+ * End-to-end parse throughput benchmark.
+ *
+ * Parses every file under the given paths (default: `examples`) with a
+ * single parser and prints the results as a JSON object on stdout.
+ *
+ *     bench/parse [-r repeat] [path...]
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "common.h"
+#include "tree_sitter/api.h"
+#include "tree_sitter/tree-sitter-bash.h"
+
+#include <stddef.h>
+
+static SourceFiles files;
+
+// Each allocation made through the counting allocator is prefixed with its
+// size, so that frees can be accounted for.
+#define ALLOCATION_HEADER_SIZE sizeof(max_align_t)
+
+static size_t live_bytes;
+
+static void *counting_malloc(size_t size) {
+    size_t *block = malloc(ALLOCATION_HEADER_SIZE + size);
+    if (!block) {
+        return NULL;
+    }
+    *block = size;
+    live_bytes += size;
+    return (char *)block + ALLOCATION_HEADER_SIZE;
+}
+
+static void *counting_calloc(size_t count, size_t size) {
+    if (size && count > SIZE_MAX / size) {
+        return NULL;
+    }
+    void *result = counting_malloc(count * size);
+    if (result) {
+        memset(result, 0, count * size);
+    }
+    return result;
+}
+
+static void *counting_realloc(void *ptr, size_t size) {
+    if (!ptr) {
+        return counting_malloc(size);
+    }
+    size_t *block = (size_t *)((char *)ptr - ALLOCATION_HEADER_SIZE);
+    size_t old_size = *block;
+    block = realloc(block, ALLOCATION_HEADER_SIZE + size);
+    if (!block) {
+        return NULL;
+    }
+    *block = size;
+    live_bytes += size - old_size;
+    return (char *)block + ALLOCATION_HEADER_SIZE;
+}
+
+static void counting_free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    size_t *block = (size_t *)((char *)ptr - ALLOCATION_HEADER_SIZE);
+    live_bytes -= *block;
+    free(block);
+}
+
+#ifdef TREE_SITTER_BASH_STATS
+static void print_scanner_stats(const TSBashScannerStats *stats, uint64_t total_bytes) {
+    uint64_t calls = 0;
+    uint64_t returns = 0;
+    uint64_t lookahead = 0;
+    for (unsigned i = 0; i < TREE_SITTER_BASH_EXTERNAL_TOKEN_COUNT; i++) {
+        calls += stats->tokens[i].calls;
+        returns += stats->tokens[i].returns;
+        lookahead += stats->tokens[i].lookahead;
+    }
+
+    double kilobytes = (double)total_bytes / 1024.0;
+    printf("  \"scanner\": {\n");
+    printf("    \"calls_per_kb\": %.1f,\n", (double)calls / kilobytes);
+    printf("    \"false_fraction\": %.4f,\n", calls ? (double)(calls - returns) / (double)calls : 0.0);
+    // Characters read past the end of each returned token, including those
+    // read by the calls that returned nothing.
+    printf("    \"lookahead_per_token\": %.2f,\n", returns ? (double)lookahead / (double)returns : 0.0);
+    printf("    \"serialized_bytes_per_token\": %.2f,\n",
+           stats->serializations ? (double)stats->serialized_bytes / (double)stats->serializations : 0.0);
+    printf("    \"large_state_fraction\": %.4f,\n",
+           stats->serializations ? (double)stats->serialized_large / (double)stats->serializations : 0.0);
+    printf("    \"tokens\": {\n");
+    bool first = true;
+    for (unsigned i = 0; i < TREE_SITTER_BASH_EXTERNAL_TOKEN_COUNT; i++) {
+        const TSBashScannerTokenStats *token = &stats->tokens[i];
+        if (token->calls == 0) {
+            continue;
+        }
+        printf("%s      \"%s\": {\"calls\": %llu, \"returns\": %llu, \"consumed\": %llu, \"lookahead\": %llu, "
+               "\"get_column_calls\": %llu}",
+               first ? "" : ",\n", tree_sitter_bash_external_scanner_token_name(i), (unsigned long long)token->calls,
+               (unsigned long long)token->returns, (unsigned long long)token->consumed,
+               (unsigned long long)token->lookahead, (unsigned long long)token->get_column_calls);
+        first = false;
+    }
+    printf("\n    }\n");
+    printf("  },\n");
+}
+#endif
+
+typedef struct {
+    uint64_t bytes;
+    uint64_t nodes;
+    uint64_t named_nodes;
+    // The steps the parser took, one per stack version per token, and how
+    // many of them it took while it was split into several versions.
+    uint64_t steps;
+    uint64_t split_steps;
+} TreeStats;
+
+static void count_step(void *payload, TSLogType type, const char *message) {
+    unsigned version;
+    unsigned version_count;
+    if (type == TSLogTypeParse &&
+        sscanf(message, "process version:%u, version_count:%u", &version, &version_count) == 2) {
+        TreeStats *stats = payload;
+        stats->steps++;
+        if (version_count > 1) {
+            stats->split_steps++;
+        }
+    }
+}
+
+static void count_nodes(TSTree *tree, TreeStats *stats) {
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+    for (;;) {
+        stats->nodes++;
+        if (ts_node_is_named(ts_tree_cursor_current_node(&cursor))) {
+            stats->named_nodes++;
+        }
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * Parses every file once more with the counting allocator and a logger
+ * installed, and measures the bytes that the trees hold on to, the visible
+ * nodes in them and the steps it took to build them. This runs after the
+ * timed parses, so that they don't pay for the accounting.
+ */
+static TreeStats measure_trees(void) {
+    ts_set_allocator(counting_malloc, counting_calloc, counting_realloc, counting_free);
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_bash());
+
+    TreeStats stats = {0};
+    ts_parser_set_logger(parser, (TSLogger){.payload = &stats, .log = count_step});
+    for (size_t i = 0; i < files.size; i++) {
+        SourceFile *file = &files.contents[i];
+        TSTree *tree = ts_parser_parse_string(parser, NULL, file->contents, file->length);
+        size_t with_tree = live_bytes;
+        count_nodes(tree, &stats);
+        ts_tree_delete(tree);
+        stats.bytes += with_tree - live_bytes;
+    }
+
+    ts_parser_delete(parser);
+    return stats;
+}
+
+int main(int argc, char **argv) {
+    unsigned repeat = 1;
+    int first_path = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-r") == 0) {
+        repeat = (unsigned)strtoul(argv[2], NULL, 10);
+        repeat = repeat ? repeat : 1;
+        first_path = 3;
+    }
+
+    if (first_path >= argc) {
+        add_sources(&files, "examples", false);
+    }
+    for (int i = first_path; i < argc; i++) {
+        if (!add_sources(&files, argv[i], false)) {
+            return 1;
+        }
+    }
+
+    if (files.size == 0) {
+        fprintf(stderr, "bench: no input files\n");
+        return 1;
+    }
+
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_bash());
+
+    size_t sample_count = files.size * repeat;
+    double *latencies = malloc(sample_count * sizeof(double));
+    uint64_t total_bytes = 0;
+    size_t error_count = 0;
+    double total_time = 0;
+#ifdef TREE_SITTER_BASH_STATS
+    TSBashScannerStats stats = {0};
+    tree_sitter_bash_external_scanner_collect_stats(&stats);
+#endif
+
+    for (unsigned r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < files.size; i++) {
+            SourceFile *file = &files.contents[i];
+
+            double start = now();
+            TSTree *tree = ts_parser_parse_string(parser, NULL, file->contents, file->length);
+            double elapsed = now() - start;
+
+            if (r == 0 && ts_node_has_error(ts_tree_root_node(tree))) {
+                error_count++;
+            }
+            ts_tree_delete(tree);
+
+            latencies[r * files.size + i] = elapsed;
+            total_time += elapsed;
+            total_bytes += file->length;
+        }
+    }
+
+#ifdef TREE_SITTER_BASH_STATS
+    tree_sitter_bash_external_scanner_collect_stats(NULL);
+#endif
+    ts_parser_delete(parser);
+    qsort(latencies, sample_count, sizeof(double), compare_doubles);
+    TreeStats trees = measure_trees();
+    double file_kilobytes = (double)(total_bytes / repeat) / 1024.0;
+
+    printf("{\n");
+    printf("  \"files\": %zu,\n", files.size);
+    printf("  \"repeat\": %u,\n", repeat);
+    printf("  \"bytes\": %llu,\n", (unsigned long long)total_bytes);
+    printf("  \"files_with_errors\": %zu,\n", error_count);
+    printf("  \"seconds\": %.6f,\n", total_time);
+    printf("  \"mb_per_s\": %.3f,\n", (double)total_bytes / 1e6 / total_time);
+    printf("  \"files_per_s\": %.1f,\n", (double)sample_count / total_time);
+    printf("  \"tree_bytes_per_kb\": %.0f,\n", (double)trees.bytes / file_kilobytes);
+    printf("  \"nodes_per_kb\": %.1f,\n", (double)trees.nodes / file_kilobytes);
+    printf("  \"named_nodes_per_kb\": %.1f,\n", (double)trees.named_nodes / file_kilobytes);
+    printf("  \"parse_steps_per_kb\": %.1f,\n", (double)trees.steps / file_kilobytes);
+    printf("  \"split_steps_per_kb\": %.1f,\n", (double)trees.split_steps / file_kilobytes);
+#ifdef TREE_SITTER_BASH_STATS
+    print_scanner_stats(&stats, total_bytes);
+#endif
+    printf("  \"latency_ms\": {\n");
+    printf("    \"p50\": %.4f,\n", percentile(latencies, sample_count, 0.50) * 1e3);
+    printf("    \"p99\": %.4f,\n", percentile(latencies, sample_count, 0.99) * 1e3);
+    printf("    \"max\": %.4f\n", latencies[sample_count - 1] * 1e3);
+    printf("  }\n");
+    printf("}\n");
+
+    delete_sources(&files);
+    free(latencies);
+    return 0;
+}
@@ -0,0 +1,588 @@
+/**
+ * External scanner microbenchmark.
+ *
+ * Drives `src/scanner.c` directly through an in-memory TSLexer, so the cost
+ * of each external token can be measured without the parse tables. Every
+ * iteration deserializes the case's starting state and calls scan(), which
+ * mirrors what the runtime does before each external token.
+ *
+ * After the cases, it measures how much of a long heredoc body has to be
+ * scanned again after a one-character insertion, the way an incremental
+ * parse would: from the start of the chunk holding the edit until a chunk
+ * ends where an old one ended. Select it with the name `heredoc_edits`.
+ *
+ *     bench/scanner [-n min-iterations] [case...]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// Route the scanner's allocations through counters, so that the benchmark can
+// report whether a token's scan loop touches the allocator. The scanner only
+// calls ts_malloc and ts_realloc.
+static uint64_t allocation_count;
+
+static void *counting_malloc(size_t size) {
+    allocation_count++;
+    return malloc(size);
+}
+
+static void *counting_realloc(void *ptr, size_t size) {
+    allocation_count++;
+    return realloc(ptr, size);
+}
+
+#define ts_malloc  counting_malloc
+#define ts_realloc counting_realloc
+
+#include "../src/scanner.c"
+
+#include <stdio.h>
+#include <time.h>
+
+#define BIT(token) (1ULL << (token))
+
+static const char *const TOKEN_LABELS[] = {
+    [HEREDOC_START] = "HEREDOC_START",
+    [SIMPLE_HEREDOC_BODY] = "SIMPLE_HEREDOC_BODY",
+    [HEREDOC_BODY_BEGINNING] = "HEREDOC_BODY_BEGINNING",
+    [HEREDOC_CONTENT] = "HEREDOC_CONTENT",
+    [HEREDOC_END] = "HEREDOC_END",
+    [FILE_DESCRIPTOR] = "FILE_DESCRIPTOR",
+    [EMPTY_VALUE] = "EMPTY_VALUE",
+    [CONCAT] = "CONCAT",
+    [VARIABLE_NAME] = "VARIABLE_NAME",
+    [TEST_OPERATOR] = "TEST_OPERATOR",
+    [REGEX] = "REGEX",
+    [REGEX_NO_SLASH] = "REGEX_NO_SLASH",
+    [REGEX_NO_SPACE] = "REGEX_NO_SPACE",
+    [EXPANSION_WORD] = "EXPANSION_WORD",
+    [EXTGLOB_PATTERN] = "EXTGLOB_PATTERN",
+    [BARE_DOLLAR] = "BARE_DOLLAR",
+    [BRACE_START] = "BRACE_START",
+    [IMMEDIATE_DOUBLE_HASH] = "IMMEDIATE_DOUBLE_HASH",
+    [EXTERNAL_EXPANSION_SYM_HASH] = "EXTERNAL_EXPANSION_SYM_HASH",
+    [EXTERNAL_EXPANSION_SYM_BANG] = "EXTERNAL_EXPANSION_SYM_BANG",
+    [EXTERNAL_EXPANSION_SYM_EQUAL] = "EXTERNAL_EXPANSION_SYM_EQUAL",
+    [CLOSING_BRACE] = "CLOSING_BRACE",
+    [CLOSING_BRACKET] = "CLOSING_BRACKET",
+    [HEREDOC_ARROW] = "HEREDOC_ARROW",
+    [HEREDOC_ARROW_DASH] = "HEREDOC_ARROW_DASH",
+    [NEWLINE] = "NEWLINE",
+    [OPENING_PAREN] = "OPENING_PAREN",
+    [RAW_HEREDOC_CONTENT] = "RAW_HEREDOC_CONTENT",
+    [PAYLOAD_START] = "PAYLOAD_START",
+    [PAYLOAD_CONTENT] = "PAYLOAD_CONTENT",
+    [SCRIPT_START] = "SCRIPT_START",
+    [ERROR_RECOVERY] = "ERROR_RECOVERY",
+};
+
+typedef struct {
+    TSLexer lexer;
+    const char *input;
+    uint32_t length;
+    uint32_t position;
+    uint32_t line_start;
+    uint32_t token_start;
+    uint32_t token_end;
+    bool did_mark_end;
+    uint64_t advance_count;
+    uint64_t get_column_count;
+} MockLexer;
+
+static void mock_advance(TSLexer *lexer, bool skip) {
+    MockLexer *self = (MockLexer *)lexer;
+    if (self->position < self->length) {
+        if (self->input[self->position] == '\n') {
+            self->line_start = self->position + 1;
+        }
+        self->position++;
+        self->advance_count++;
+    }
+    if (skip) {
+        self->token_start = self->position;
+    }
+    self->lexer.lookahead = self->position < self->length ? (unsigned char)self->input[self->position] : 0;
+}
+
+static void mock_mark_end(TSLexer *lexer) {
+    MockLexer *self = (MockLexer *)lexer;
+    self->token_end = self->position;
+    self->did_mark_end = true;
+}
+
+// Like the runtime, a token without an explicit mark_end ends at the current
+// position.
+static uint32_t mock_token_length(const MockLexer *self) {
+    uint32_t end = self->did_mark_end ? self->token_end : self->position;
+    return end > self->token_start ? end - self->token_start : 0;
+}
+
+static uint32_t mock_get_column(TSLexer *lexer) {
+    MockLexer *self = (MockLexer *)lexer;
+    self->get_column_count++;
+    return self->position - self->line_start;
+}
+
+static bool mock_is_at_included_range_start(const TSLexer *lexer) {
+    (void)lexer;
+    return false;
+}
+
+static bool mock_eof(const TSLexer *lexer) {
+    const MockLexer *self = (const MockLexer *)lexer;
+    return self->position >= self->length;
+}
+
+static void mock_log(const TSLexer *lexer, const char *format, ...) {
+    (void)lexer;
+    (void)format;
+}
+
+static void mock_lexer_reset(MockLexer *self, const char *input, uint32_t length) {
+    self->lexer.lookahead = length > 0 ? (unsigned char)input[0] : 0;
+    self->lexer.result_symbol = 0;
+    self->lexer.advance = mock_advance;
+    self->lexer.mark_end = mock_mark_end;
+    self->lexer.get_column = mock_get_column;
+    self->lexer.is_at_included_range_start = mock_is_at_included_range_start;
+    self->lexer.eof = mock_eof;
+    self->lexer.log = mock_log;
+    self->input = input;
+    self->length = length;
+    self->position = 0;
+    self->line_start = 0;
+    self->token_start = 0;
+    self->token_end = 0;
+    self->did_mark_end = false;
+}
+
+// Moves the lexer to `position`, as the runtime does when it starts a token
+// in the middle of the input.
+static void mock_lexer_seek(MockLexer *self, uint32_t position) {
+    self->position = position;
+    self->token_start = position;
+    self->line_start = position;
+    while (self->line_start > 0 && self->input[self->line_start - 1] != '\n') {
+        self->line_start--;
+    }
+    self->lexer.lookahead = position < self->length ? (unsigned char)self->input[position] : 0;
+}
+
+static void valid_symbols_from_mask(uint64_t mask, bool *valid_symbols) {
+    for (unsigned i = 0; i <= ERROR_RECOVERY; i++) {
+        valid_symbols[i] = (mask & BIT(i)) != 0;
+    }
+}
+
+/**
+ * A step that is run once to bring the scanner into the state a case needs,
+ * for example a pending heredoc.
+ */
+typedef struct {
+    uint64_t valid_symbols;
+    const char *input;
+} SetupStep;
+
+typedef struct {
+    const char *name;
+    enum TokenType token;
+    uint64_t valid_symbols;
+    const char *input;
+    const SetupStep *setup;
+    // Generated input: `prefix`, then `input` repeated this many times,
+    // followed by `suffix`.
+    unsigned repeat;
+    const char *suffix;
+    const char *prefix;
+} BenchCase;
+
+#define STATEMENT_START (BIT(VARIABLE_NAME) | BIT(FILE_DESCRIPTOR) | BIT(HEREDOC_ARROW) | BIT(BARE_DOLLAR))
+// The states between the arguments of a command, where a redirect may follow.
+#define AFTER_ARGUMENT (BIT(FILE_DESCRIPTOR) | BIT(HEREDOC_ARROW) | BIT(HEREDOC_ARROW_DASH) | BIT(NEWLINE))
+// The start of a case item's pattern.
+#define CASE_PATTERN (BIT(TEST_OPERATOR) | BIT(EXTGLOB_PATTERN) | BIT(BRACE_START) | BIT(OPENING_PAREN))
+
+static const SetupStep PENDING_HEREDOC[] = {
+    {STATEMENT_START, "<<EOF"},
+    {BIT(HEREDOC_START), "EOF\n"},
+    {0, NULL},
+};
+
+static const SetupStep PENDING_RAW_HEREDOC[] = {
+    {STATEMENT_START, "<<'EOF'"},
+    {BIT(HEREDOC_START), "'EOF'\n"},
+    {0, NULL},
+};
+
+static const SetupStep STARTED_HEREDOC[] = {
+    {STATEMENT_START, "<<EOF"},
+    {BIT(HEREDOC_START), "EOF\n"},
+    {BIT(HEREDOC_BODY_BEGINNING) | BIT(SIMPLE_HEREDOC_BODY), "$x\n"},
+    {0, NULL},
+};
+
+static const BenchCase CASES[] = {
+    {"concat", CONCAT, BIT(CONCAT) | BIT(CLOSING_BRACE), "bar baz"},
+    {"concat_miss", CONCAT, BIT(CONCAT), " baz"},
+    {"concat_backtick", CONCAT, BIT(CONCAT), "`basename \"$0\"` x"},
+    {"unterminated_backtick", CONCAT, BIT(CONCAT), "echo no closing backtick\n", NULL, 16 * 1024, "", "`"},
+    {"variable_name", VARIABLE_NAME, STATEMENT_START, "LONG_VARIABLE_NAME=value"},
+    {"variable_name_miss", VARIABLE_NAME, STATEMENT_START, "echo hello"},
+    {"file_descriptor", FILE_DESCRIPTOR, STATEMENT_START, "2>&1"},
+    {"argument_miss", FILE_DESCRIPTOR, AFTER_ARGUMENT, "--verbose"},
+    {"expansion_argument", BARE_DOLLAR, AFTER_ARGUMENT | BIT(TEST_OPERATOR) | BIT(BARE_DOLLAR) | BIT(BRACE_START),
+     "$HOME/bin"},
+    {"case_pattern_miss", EXTGLOB_PATTERN, CASE_PATTERN, "start)"},
+    {"heredoc_arrow", HEREDOC_ARROW, STATEMENT_START, "<<EOF"},
+    {"heredoc_start", HEREDOC_START, BIT(HEREDOC_START), "END_OF_INPUT\n", PENDING_HEREDOC},
+    {"simple_heredoc_body", SIMPLE_HEREDOC_BODY, BIT(HEREDOC_BODY_BEGINNING) | BIT(SIMPLE_HEREDOC_BODY),
+     "  plain line of heredoc text without any expansions in it\n", PENDING_HEREDOC, 64, "EOF\n"},
+    {"raw_heredoc_body", SIMPLE_HEREDOC_BODY, BIT(HEREDOC_BODY_BEGINNING) | BIT(SIMPLE_HEREDOC_BODY),
+     "  raw heredoc text with $literal ${dollars} and $(parens)\n", PENDING_RAW_HEREDOC, 64, "EOF\n"},
+    {"heredoc_content", HEREDOC_CONTENT, BIT(HEREDOC_CONTENT) | BIT(HEREDOC_END),
+     "  heredoc text that is followed by an expansion later on\n", STARTED_HEREDOC, 64, "$var\nEOF\n"},
+    {"heredoc_body_expansions", HEREDOC_BODY_BEGINNING, BIT(HEREDOC_BODY_BEGINNING) | BIT(SIMPLE_HEREDOC_BODY),
+     "  key: $value ${other:-default} $(command -v x)\n", PENDING_HEREDOC, 64, "EOF\n"},
+    {"long_line_heredoc_body", SIMPLE_HEREDOC_BODY, BIT(HEREDOC_BODY_BEGINNING) | BIT(SIMPLE_HEREDOC_BODY),
+     "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVo=", PENDING_HEREDOC, 64 * 1024, "\nEOF\n"},
+    {"large_heredoc_body", HEREDOC_BODY_BEGINNING, BIT(HEREDOC_BODY_BEGINNING) | BIT(SIMPLE_HEREDOC_BODY),
+     "  plain line of heredoc text without any expansions in it\n", PENDING_HEREDOC, 64 * 1024, "EOF\n"},
+    {"payload_marker", PAYLOAD_START, STATEMENT_START | BIT(PAYLOAD_START),
+     "H4sIAAAAAAAAA+3OMQqAMBBE0T3K/ABTXXt3AQ==\n", NULL, 1024, "", "__ARCHIVE_BELOW__\n"},
+    {"binary_payload", PAYLOAD_START, STATEMENT_START | BIT(PAYLOAD_START), "\x8b\x08\x1b\x7f#!/bin/sh\n$(\x01\x02",
+     NULL, 1024, "", "\x1f"},
+    {"script_start", SCRIPT_START, STATEMENT_START | BIT(SCRIPT_START) | BIT(PAYLOAD_START),
+     "if [ -f \"$HOME/.profile\" ]; then . \"$HOME/.profile\"; fi\n", NULL, 256, "", "#!/bin/sh\n"},
+    {"minified_input", PAYLOAD_START, STATEMENT_START | BIT(SCRIPT_START) | BIT(PAYLOAD_START),
+     "!function(e){var t={};function n(r){if(t[r])return t[r].exports}}", NULL, 1024},
+    {"control_bytes_input", PAYLOAD_START, STATEMENT_START | BIT(SCRIPT_START) | BIT(PAYLOAD_START),
+     "\x14\x08\x08\x1b\x9c\x7f\x01" "ab\x02\x03\xfe", NULL, 1024, "", "PK\x03\x04"},
+    {"heredoc_end", HEREDOC_END, BIT(HEREDOC_CONTENT) | BIT(HEREDOC_END), "EOF\n", STARTED_HEREDOC},
+    {"test_operator", TEST_OPERATOR, BIT(TEST_OPERATOR) | STATEMENT_START, "-f /etc/passwd ]]"},
+    {"regex", REGEX, BIT(REGEX), "^([a-z]+)-(foo|bar)[0-9]{2,}$ ]]"},
+    {"regex_no_space", REGEX_NO_SPACE, BIT(REGEX_NO_SPACE) | BIT(TEST_OPERATOR), "^[0-9]+\\.[0-9]+$ ]]"},
+    {"unterminated_regex", REGEX, BIT(REGEX), "[[ $x =~ (foo|bar\n", NULL, 16 * 1024},
+    {"regex_no_slash", REGEX_NO_SLASH, BIT(REGEX_NO_SLASH) | BIT(VARIABLE_NAME), "foo*bar/baz}"},
+    {"extglob_pattern", EXTGLOB_PATTERN, BIT(EXTGLOB_PATTERN), "@(foo|bar)*.txt) echo"},
+    {"unterminated_extglob", EXTGLOB_PATTERN, BIT(EXTGLOB_PATTERN), "@(foo|bar", NULL, 16 * 1024},
+    {"expansion_word", EXPANSION_WORD, BIT(EXPANSION_WORD) | BIT(CLOSING_BRACE), "some default value}"},
+    {"brace_start", BRACE_START, BIT(BRACE_START), "{1..100}"},
+    {"empty_value", EMPTY_VALUE, BIT(EMPTY_VALUE), " echo"},
+    {"bare_dollar", BARE_DOLLAR, BIT(BARE_DOLLAR), "$ "},
+    {"immediate_double_hash", IMMEDIATE_DOUBLE_HASH, BIT(IMMEDIATE_DOUBLE_HASH), "##*/}"},
+    {"expansion_sym_hash", EXTERNAL_EXPANSION_SYM_HASH, BIT(EXTERNAL_EXPANSION_SYM_HASH), "#}"},
+};
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static char *build_input(const BenchCase *bench_case, uint32_t *length) {
+    unsigned repeat = bench_case->repeat ? bench_case->repeat : 1;
+    const char *suffix = bench_case->suffix ? bench_case->suffix : "";
+    const char *prefix = bench_case->prefix ? bench_case->prefix : "";
+    size_t prefix_length = strlen(prefix);
+    size_t input_length = strlen(bench_case->input);
+    size_t total = prefix_length + input_length * repeat + strlen(suffix);
+
+    char *input = malloc(total + 1);
+    memcpy(input, prefix, prefix_length);
+    for (unsigned i = 0; i < repeat; i++) {
+        memcpy(&input[prefix_length + i * input_length], bench_case->input, input_length);
+    }
+    strcpy(&input[prefix_length + input_length * repeat], suffix);
+    *length = (uint32_t)total;
+    return input;
+}
+
+/**
+ * Measures deserializing the same state over and over, which is what the
+ * runtime does between consecutive external tokens that leave it unchanged.
+ */
+static double time_deserialize(void *scanner, const char *state, unsigned state_length, uint64_t min_iterations) {
+    uint64_t iterations = 0;
+    double elapsed = 0;
+    for (uint64_t batch = min_iterations; elapsed < 0.02; batch *= 2) {
+        double start = now();
+        for (uint64_t i = 0; i < batch; i++) {
+            tree_sitter_bash_external_scanner_deserialize(scanner, state, state_length);
+        }
+        elapsed += now() - start;
+        iterations += batch;
+    }
+    return elapsed * 1e9 / (double)iterations;
+}
+
+static void run_setup(void *scanner, const SetupStep *setup) {
+    bool valid_symbols[ERROR_RECOVERY + 1];
+    MockLexer mock;
+
+    for (const SetupStep *step = setup; step && step->input; step++) {
+        valid_symbols_from_mask(step->valid_symbols, valid_symbols);
+        mock_lexer_reset(&mock, step->input, (uint32_t)strlen(step->input));
+        tree_sitter_bash_external_scanner_scan(scanner, &mock.lexer, valid_symbols);
+    }
+}
+
+static void run_case(const BenchCase *bench_case, uint64_t min_iterations, bool last) {
+    bool valid_symbols[ERROR_RECOVERY + 1];
+    char state[TREE_SITTER_SERIALIZATION_BUFFER_SIZE];
+    MockLexer mock;
+
+    void *scanner = tree_sitter_bash_external_scanner_create();
+    run_setup(scanner, bench_case->setup);
+    unsigned state_length = tree_sitter_bash_external_scanner_serialize(scanner, state);
+
+    double deserialize_ns = time_deserialize(scanner, state, state_length, min_iterations);
+
+    uint32_t length;
+    char *input = build_input(bench_case, &length);
+    valid_symbols_from_mask(bench_case->valid_symbols, valid_symbols);
+
+    bool result = false;
+    TSSymbol result_symbol = 0;
+    uint32_t token_length = 0;
+    uint64_t iterations = 0;
+    uint64_t advanced = 0;
+    uint64_t get_column_calls = 0;
+    uint64_t allocations = 0;
+    double elapsed = 0;
+
+    for (uint64_t batch = min_iterations; elapsed < 0.05; batch *= 2) {
+        mock.advance_count = 0;
+        mock.get_column_count = 0;
+        allocation_count = 0;
+        double start = now();
+        for (uint64_t i = 0; i < batch; i++) {
+            tree_sitter_bash_external_scanner_deserialize(scanner, state, state_length);
+            mock_lexer_reset(&mock, input, length);
+            result = tree_sitter_bash_external_scanner_scan(scanner, &mock.lexer, valid_symbols);
+        }
+        elapsed += now() - start;
+        iterations += batch;
+        advanced += mock.advance_count;
+        get_column_calls += mock.get_column_count;
+        allocations += allocation_count;
+        result_symbol = mock.lexer.result_symbol;
+        token_length = mock_token_length(&mock);
+    }
+
+    printf("    {\"case\": \"%s\", \"token\": \"%s\", \"result\": %s, \"result_symbol\": \"%s\", ", bench_case->name,
+           TOKEN_LABELS[bench_case->token], result ? "true" : "false",
+           result && result_symbol <= ERROR_RECOVERY ? TOKEN_LABELS[result_symbol] : "");
+    printf("\"input_bytes\": %u, \"token_bytes\": %u, \"ns_per_call\": %.1f, \"bytes_advanced_per_call\": %.1f, "
+           "\"get_column_per_call\": %.1f, \"allocations_per_call\": %.2f, \"state_bytes\": %u, "
+           "\"deserialize_ns\": %.1f}%s\n",
+           length, result ? token_length : 0, elapsed * 1e9 / (double)iterations,
+           (double)advanced / (double)iterations, (double)get_column_calls / (double)iterations,
+           (double)allocations / (double)iterations, state_length, deserialize_ns, last ? "" : ",");
+
+    free(input);
+    tree_sitter_bash_external_scanner_destroy(scanner);
+}
+
+// The sizes of the heredoc bodies that edits are measured in.
+static const uint32_t EDIT_BODY_SIZES[] = {64 * 1024, 1024 * 1024, 5 * 1024 * 1024};
+
+// How many one-character insertions are measured in each body.
+#define EDITS_PER_BODY 200
+
+// A fixed seed, so that every run measures the same bodies and edits.
+static uint64_t random_state = 88172645463325252ULL;
+
+static uint64_t next_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+// Lines of a few words each, like a configuration file, so that the lines
+// vary in length and contents, followed by the delimiter and one more
+// command.
+static char *build_heredoc_body(uint32_t size, uint32_t *body_length, uint32_t *length) {
+    static const char *const words[] = {"alpha", "beta", "gamma", "delta", "key", "value", "=",
+                                        ":",     "{",    "}",     "\"x\"",  "42",  "  ",    "-"};
+    const unsigned word_count = sizeof(words) / sizeof(words[0]);
+
+    char *input = malloc(size + 256);
+    uint32_t end = 0;
+    while (end < size) {
+        for (unsigned i = 1 + next_random() % 12; i > 0; i--) {
+            end += (uint32_t)sprintf(&input[end], "%s ", words[next_random() % word_count]);
+        }
+        input[end++] = '\n';
+    }
+    *body_length = end;
+    *length = end + (uint32_t)sprintf(&input[end], "EOF\necho\n");
+    return input;
+}
+
+// Scans one heredoc body token at `position`, from the scanner state before
+// the body or, for any later chunk, from the one after its first chunk. It
+// returns where the token ends, or UINT32_MAX if the scan fails.
+static uint32_t scan_heredoc_token(void *scanner, const char *input, uint32_t length, uint32_t position,
+                                   const char *state, unsigned state_length, bool is_first, bool *is_last,
+                                   uint64_t *advanced) {
+    bool valid_symbols[ERROR_RECOVERY + 1];
+    MockLexer mock;
+
+    tree_sitter_bash_external_scanner_deserialize(scanner, state, state_length);
+    valid_symbols_from_mask(is_first ? BIT(HEREDOC_BODY_BEGINNING) | BIT(SIMPLE_HEREDOC_BODY)
+                                     : BIT(HEREDOC_CONTENT) | BIT(HEREDOC_END),
+                            valid_symbols);
+    mock_lexer_reset(&mock, input, length);
+    mock_lexer_seek(&mock, position);
+    mock.advance_count = 0;
+    if (!tree_sitter_bash_external_scanner_scan(scanner, &mock.lexer, valid_symbols)) {
+        return UINT32_MAX;
+    }
+    *advanced += mock.advance_count;
+    *is_last = mock.lexer.result_symbol == SIMPLE_HEREDOC_BODY || mock.lexer.result_symbol == HEREDOC_END;
+    return mock.did_mark_end ? mock.token_end : mock.position;
+}
+
+static int compare_counts(const void *a, const void *b) {
+    uint64_t left = *(const uint64_t *)a;
+    uint64_t right = *(const uint64_t *)b;
+    return (left > right) - (left < right);
+}
+
+static void run_heredoc_edits(uint32_t size, bool last) {
+    char body_state[TREE_SITTER_SERIALIZATION_BUFFER_SIZE];
+    char chunk_state[TREE_SITTER_SERIALIZATION_BUFFER_SIZE];
+    unsigned chunk_state_length = 0;
+
+    void *scanner = tree_sitter_bash_external_scanner_create();
+    run_setup(scanner, PENDING_HEREDOC);
+    unsigned body_state_length = tree_sitter_bash_external_scanner_serialize(scanner, body_state);
+
+    uint32_t body_length;
+    uint32_t length;
+    char *input = build_heredoc_body(size, &body_length, &length);
+
+    // Where each token of the unedited body ends.
+    uint32_t *ends = malloc(sizeof(uint32_t) * (body_length + 1));
+    uint32_t token_count = 0;
+    uint64_t advanced = 0;
+    bool is_last = false;
+    for (uint32_t position = 0; !is_last;) {
+        bool is_first = token_count == 0;
+        position = scan_heredoc_token(scanner, input, length, position, is_first ? body_state : chunk_state,
+                                      is_first ? body_state_length : chunk_state_length, is_first, &is_last,
+                                      &advanced);
+        if (position == UINT32_MAX) {
+            fprintf(stderr, "scanner: heredoc body of %u bytes failed to scan\n", body_length);
+            exit(1);
+        }
+        if (is_first) {
+            chunk_state_length = tree_sitter_bash_external_scanner_serialize(scanner, chunk_state);
+        }
+        ends[token_count++] = position;
+    }
+
+    uint64_t rescanned[EDITS_PER_BODY];
+    char *edited = malloc(length + 1);
+    for (unsigned e = 0; e < EDITS_PER_BODY; e++) {
+        uint32_t offset = (uint32_t)(next_random() % body_length);
+        memcpy(edited, input, offset);
+        edited[offset] = 'x';
+        memcpy(&edited[offset + 1], &input[offset], length - offset);
+
+        // Scan again from the start of the token that held the edit, until a
+        // token after the edit ends where an old one did, one byte later.
+        uint32_t token = 0;
+        uint32_t position = 0;
+        while (token < token_count && ends[token] <= offset) {
+            position = ends[token++];
+        }
+        rescanned[e] = 0;
+        is_last = false;
+        for (bool is_first = token == 0; !is_last; is_first = false) {
+            position = scan_heredoc_token(scanner, edited, length + 1, position, is_first ? body_state : chunk_state,
+                                          is_first ? body_state_length : chunk_state_length, is_first, &is_last,
+                                          &rescanned[e]);
+            if (position == UINT32_MAX) {
+                fprintf(stderr, "scanner: edited heredoc body of %u bytes failed to scan\n", body_length);
+                exit(1);
+            }
+            while (token < token_count && ends[token] + 1 < position) {
+                token++;
+            }
+            if (token < token_count && ends[token] + 1 == position && position > offset + 1) {
+                break;
+            }
+        }
+    }
+    qsort(rescanned, EDITS_PER_BODY, sizeof(rescanned[0]), compare_counts);
+    uint64_t total = 0;
+    for (unsigned e = 0; e < EDITS_PER_BODY; e++) {
+        total += rescanned[e];
+    }
+
+    printf("    {\"body_bytes\": %u, \"tokens\": %u, \"edits\": %u, \"rescanned_mean\": %.0f, "
+           "\"rescanned_p99\": %llu, \"rescanned_max\": %llu}%s\n",
+           body_length, token_count, EDITS_PER_BODY, (double)total / EDITS_PER_BODY,
+           (unsigned long long)rescanned[EDITS_PER_BODY * 99 / 100],
+           (unsigned long long)rescanned[EDITS_PER_BODY - 1], last ? "" : ",");
+
+    free(edited);
+    free(ends);
+    free(input);
+    tree_sitter_bash_external_scanner_destroy(scanner);
+}
+
+static bool is_selected(const char *name, int argc, char **argv, int first) {
+    if (first >= argc) {
+        return true;
+    }
+    for (int i = first; i < argc; i++) {
+        if (strcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv) {
+    uint64_t min_iterations = 1000;
+    int first_case = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        min_iterations = strtoull(argv[2], NULL, 10);
+        min_iterations = min_iterations ? min_iterations : 1;
+        first_case = 3;
+    }
+
+    size_t case_count = sizeof(CASES) / sizeof(CASES[0]);
+    size_t last_selected = case_count;
+    for (size_t i = 0; i < case_count; i++) {
+        if (is_selected(CASES[i].name, argc, argv, first_case)) {
+            last_selected = i;
+        }
+    }
+
+    printf("{\n  \"cases\": [\n");
+    for (size_t i = 0; i < case_count; i++) {
+        if (is_selected(CASES[i].name, argc, argv, first_case)) {
+            run_case(&CASES[i], min_iterations, i == last_selected);
+        }
+    }
+    printf("  ]");
+
+    if (is_selected("heredoc_edits", argc, argv, first_case)) {
+        size_t size_count = sizeof(EDIT_BODY_SIZES) / sizeof(EDIT_BODY_SIZES[0]);
+        printf(",\n  \"heredoc_edits\": [\n");
+        for (size_t i = 0; i < size_count; i++) {
+            run_heredoc_edits(EDIT_BODY_SIZES[i], i + 1 == size_count);
+        }
+        printf("  ]");
+    }
+    printf("\n}\n");
+    return 0;
+}
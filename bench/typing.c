@@ -0,0 +1,335 @@
+/**
+ * Keystroke latency benchmark for incremental reparsing.
+ *
+ * Replays edit scripts against every file under the given paths (default:
+ * `examples` and `test/corpus`) the way an editor sends them, one keystroke at
+ * a time: each keystroke edits the old tree with `ts_tree_edit` and reparses
+ * with it. The inputs of corpus tests are used on their own, without the
+ * expected trees. Prints the reparse latency and the size of the changed
+ * ranges of each script as a JSON object on stdout.
+ *
+ * A subtree is only reused if the scanner state it was lexed in matches, so
+ * the scripts include edits to the state that the scanner serializes: the
+ * pending heredocs and the depth of an extglob's parentheses.
+ *
+ *     bench/typing [-r repeat] [path...]
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "common.h"
+#include "tree_sitter/api.h"
+#include "tree_sitter/tree-sitter-bash.h"
+
+static SourceFiles files;
+
+typedef struct {
+    double *contents;
+    size_t size;
+    size_t capacity;
+} Samples;
+
+static void add_sample(Samples *samples, double value) {
+    if (samples->size == samples->capacity) {
+        samples->capacity = samples->capacity ? samples->capacity * 2 : 256;
+        samples->contents = realloc(samples->contents, samples->capacity * sizeof(double));
+    }
+    samples->contents[samples->size++] = value;
+}
+
+/**
+ * The state of one file while a script is typed into it. `latencies` and
+ * `changed_bytes` get a sample for every keystroke.
+ */
+typedef struct {
+    TSParser *parser;
+    TSTree *tree;
+    char *text;
+    uint32_t length;
+    Samples *latencies;
+    Samples *changed_bytes;
+    uint64_t changed_ranges;
+} Session;
+
+/**
+ * Applies a keystroke that replaces `old_length` bytes at `offset` with
+ * `new_length` bytes of `new_text`, reparses, and records the time the
+ * reparse took and the bytes in the ranges that it changed.
+ */
+static void apply_edit(Session *session, uint32_t offset, uint32_t old_length, const char *new_text,
+                       uint32_t new_length) {
+    TSInputEdit edit = edit_text(&session->text, &session->length, offset, old_length, new_text, new_length);
+    ts_tree_edit(session->tree, &edit);
+    double start = now();
+    TSTree *new_tree = ts_parser_parse_string(session->parser, session->tree, session->text, session->length);
+    double elapsed = now() - start;
+
+    uint32_t range_count;
+    TSRange *ranges = ts_tree_get_changed_ranges(session->tree, new_tree, &range_count);
+    uint64_t bytes = 0;
+    for (uint32_t i = 0; i < range_count; i++) {
+        bytes += ranges[i].end_byte - ranges[i].start_byte;
+    }
+    free(ranges);
+
+    ts_tree_delete(session->tree);
+    session->tree = new_tree;
+    add_sample(session->latencies, elapsed);
+    add_sample(session->changed_bytes, (double)bytes);
+    session->changed_ranges += range_count;
+}
+
+static void type_text(Session *session, uint32_t offset, const char *typed) {
+    for (uint32_t i = 0; typed[i]; i++) {
+        apply_edit(session, offset + i, 0, &typed[i], 1);
+    }
+}
+
+static void backspace(Session *session, uint32_t offset, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        apply_edit(session, offset - i - 1, 1, "", 0);
+    }
+}
+
+static bool is_word_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-' ||
+           c == '.' || c == '/';
+}
+
+static const char *find_word(const char *text, const char *word) {
+    size_t length = strlen(word);
+    for (const char *match = strstr(text, word); match; match = strstr(match + 1, word)) {
+        if ((match == text || !is_word_char(match[-1])) && !is_word_char(match[length])) {
+            return match;
+        }
+    }
+    return NULL;
+}
+
+// Each script types into the first place in the file where it applies, and
+// then deletes what it typed again, so that the file ends up as it started.
+// It returns false, before typing anything, if the file has no such place.
+
+// Types a line at the start of a heredoc body, so that the scanner's heredoc
+// state is in every token it returns.
+static bool type_in_heredoc(Session *session) {
+    const char *text = session->text;
+    const char *arrow = strstr(text, "<<");
+    while (arrow && arrow[2] == '<') {
+        arrow = strstr(arrow + 3, "<<");
+    }
+    const char *body = arrow ? strchr(arrow, '\n') : NULL;
+    if (!body) {
+        return false;
+    }
+
+    static const char line[] = "  key: $value ${other:-x}\n";
+    uint32_t offset = (uint32_t)(body + 1 - text);
+    type_text(session, offset, line);
+    backspace(session, offset + sizeof(line) - 1, sizeof(line) - 1);
+    return true;
+}
+
+// Quotes an argument, which leaves a string open to the end of the file in
+// between the two quotes.
+static bool insert_quotes(Session *session) {
+    const char *text = session->text;
+    const char *word = text;
+    while ((word = strchr(word, ' ')) && !(word > text && is_word_char(word[-1]) && is_word_char(word[1]))) {
+        word++;
+    }
+    if (!word) {
+        return false;
+    }
+
+    uint32_t start = (uint32_t)(word + 1 - text);
+    uint32_t end = start;
+    while (is_word_char(text[end])) {
+        end++;
+    }
+    type_text(session, start, "\"");
+    type_text(session, end + 1, "\"");
+    backspace(session, end + 2, 1);
+    backspace(session, start + 1, 1);
+    return true;
+}
+
+// Adds a command substitution to the end of the first line that has a
+// command on it, with `$(` open while the rest is typed.
+static bool open_command_substitution(Session *session) {
+    const char *text = session->text;
+    const char *line = text;
+    while (*line && !is_word_char(*line)) {
+        const char *next = strchr(line, '\n');
+        line = next ? next + 1 : line + strlen(line);
+    }
+    if (!*line) {
+        return false;
+    }
+
+    static const char typed[] = " $(date +%s)";
+    const char *line_end = strchr(line, '\n');
+    uint32_t offset = line_end ? (uint32_t)(line_end - text) : session->length;
+    type_text(session, offset, typed);
+    backspace(session, offset + sizeof(typed) - 1, sizeof(typed) - 1);
+    return true;
+}
+
+// Deletes an `esac` and types it back, so that the case statement is open
+// until the end of the file in between.
+static bool delete_esac(Session *session) {
+    const char *esac = find_word(session->text, "esac");
+    if (!esac) {
+        return false;
+    }
+
+    uint32_t offset = (uint32_t)(esac - session->text);
+    backspace(session, offset + 4, 4);
+    type_text(session, offset, "esac");
+    return true;
+}
+
+// Types an extglob in front of the first pattern of a case statement, so that
+// the scanner's glob state changes with the parentheses.
+static bool type_extglob(Session *session) {
+    const char *text = session->text;
+    const char *in = NULL;
+    for (const char *match = find_word(text, "case"); match && !in; match = find_word(match + 1, "case")) {
+        const char *line_end = strchr(match, '\n');
+        const char *word = find_word(match, "in");
+        if (word && line_end && word < line_end) {
+            in = word;
+        }
+    }
+    if (!in) {
+        return false;
+    }
+
+    const char *pattern = in + 2;
+    while (*pattern == ' ' || *pattern == '\t' || *pattern == '\n') {
+        pattern++;
+    }
+    if (!*pattern || *pattern == '\n') {
+        return false;
+    }
+
+    static const char typed[] = "@(x|y*)|";
+    uint32_t offset = (uint32_t)(pattern - text);
+    type_text(session, offset, typed);
+    backspace(session, offset + sizeof(typed) - 1, sizeof(typed) - 1);
+    return true;
+}
+
+typedef struct {
+    const char *name;
+    bool (*run)(Session *);
+} EditScript;
+
+static const EditScript SCRIPTS[] = {
+    {"heredoc_body", type_in_heredoc},
+    {"quote", insert_quotes},
+    {"command_substitution", open_command_substitution},
+    {"delete_esac", delete_esac},
+    {"extglob", type_extglob},
+};
+
+#define SCRIPT_COUNT (sizeof(SCRIPTS) / sizeof(SCRIPTS[0]))
+
+static void sort_samples(Samples *samples) {
+    qsort(samples->contents, samples->size, sizeof(double), compare_doubles);
+}
+
+static double max_sample(const Samples *samples) { return samples->size ? samples->contents[samples->size - 1] : 0; }
+
+int main(int argc, char **argv) {
+    unsigned repeat = 1;
+    int first_path = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-r") == 0) {
+        repeat = (unsigned)strtoul(argv[2], NULL, 10);
+        repeat = repeat ? repeat : 1;
+        first_path = 3;
+    }
+
+    if (first_path >= argc) {
+        add_sources(&files, "examples", true);
+        add_sources(&files, "test/corpus", true);
+    }
+    for (int i = first_path; i < argc; i++) {
+        if (!add_sources(&files, argv[i], true)) {
+            return 1;
+        }
+    }
+
+    if (files.size == 0) {
+        fprintf(stderr, "bench: no input files\n");
+        return 1;
+    }
+
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_bash());
+
+    printf("{\n");
+    printf("  \"files\": %zu,\n", files.size);
+    printf("  \"repeat\": %u,\n", repeat);
+    printf("  \"scripts\": [\n");
+    for (size_t s = 0; s < SCRIPT_COUNT; s++) {
+        Samples latencies = {0};
+        Samples changed_bytes = {0};
+        uint64_t changed_ranges = 0;
+        size_t applied = 0;
+        // Files whose tree after the script differs from a fresh parse of the
+        // same text, which means that a reused subtree was wrong.
+        size_t mismatches = 0;
+
+        for (unsigned r = 0; r < repeat; r++) {
+            for (size_t i = 0; i < files.size; i++) {
+                SourceFile *file = &files.contents[i];
+                Session session = {
+                    .parser = parser,
+                    .tree = ts_parser_parse_string(parser, NULL, file->contents, file->length),
+                    .text = strdup(file->contents),
+                    .length = file->length,
+                    .latencies = &latencies,
+                    .changed_bytes = &changed_bytes,
+                };
+
+                if (SCRIPTS[s].run(&session) && r == 0) {
+                    applied++;
+                    TSTree *fresh = ts_parser_parse_string(parser, NULL, session.text, session.length);
+                    char *expected = ts_node_string(ts_tree_root_node(fresh));
+                    char *actual = ts_node_string(ts_tree_root_node(session.tree));
+                    mismatches += strcmp(expected, actual) != 0;
+                    free(expected);
+                    free(actual);
+                    ts_tree_delete(fresh);
+                }
+                changed_ranges += session.changed_ranges;
+                ts_tree_delete(session.tree);
+                free(session.text);
+            }
+        }
+
+        printf("    {\"script\": \"%s\", \"files\": %zu, \"keystrokes\": %zu, \"tree_mismatches\": %zu, ",
+               SCRIPTS[s].name, applied, latencies.size, mismatches);
+        printf("\"changed_ranges_per_keystroke\": %.2f, ",
+               latencies.size ? (double)changed_ranges / (double)latencies.size : 0.0);
+        sort_samples(&latencies);
+        sort_samples(&changed_bytes);
+        printf("\"reparse_ms\": {\"p50\": %.4f, \"p99\": %.4f, \"max\": %.4f}, ",
+               percentile(latencies.contents, latencies.size, 0.50) * 1e3,
+               percentile(latencies.contents, latencies.size, 0.99) * 1e3, max_sample(&latencies) * 1e3);
+        printf("\"changed_bytes\": {\"p50\": %.0f, \"p99\": %.0f, \"max\": %.0f}}%s\n",
+               percentile(changed_bytes.contents, changed_bytes.size, 0.50),
+               percentile(changed_bytes.contents, changed_bytes.size, 0.99), max_sample(&changed_bytes),
+               s + 1 == SCRIPT_COUNT ? "" : ",");
+
+        free(latencies.contents);
+        free(changed_bytes.contents);
+    }
+    printf("  ]\n}\n");
+
+    ts_parser_delete(parser);
+    delete_sources(&files);
+    return 0;
+}
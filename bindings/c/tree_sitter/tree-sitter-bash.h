@@ -9,6 +9,51 @@ extern "C" {
 
 const TSLanguage *tree_sitter_bash(void);
 
+#ifdef TREE_SITTER_BASH_STATS
+
+#include <stdint.h>
+
+// The number of external tokens, plus one slot for scans that never chose a
+// token to produce.
+#define TREE_SITTER_BASH_EXTERNAL_TOKEN_COUNT 32
+
+typedef struct {
+    // Calls to the external scanner that tried to produce this token.
+    uint64_t calls;
+    // Calls that successfully produced this token.
+    uint64_t returns;
+    // Characters consumed with `advance` or `skip`.
+    uint64_t consumed;
+    // Characters consumed past the final `mark_end`; for failed calls, every
+    // consumed character.
+    uint64_t lookahead;
+    // Calls to `get_column`.
+    uint64_t get_column_calls;
+} TSBashScannerTokenStats;
+
+typedef struct {
+    TSBashScannerTokenStats tokens[TREE_SITTER_BASH_EXTERNAL_TOKEN_COUNT];
+    // Calls to `serialize`, which the runtime makes after each external token.
+    uint64_t serializations;
+    // Bytes of serialized state written by those calls.
+    uint64_t serialized_bytes;
+    // Calls that wrote more than the 24 bytes the runtime stores inline in a
+    // syntax tree node, so that the node needs a separate allocation.
+    uint64_t serialized_large;
+} TSBashScannerStats;
+
+// Adds the work of every scanner that runs on the calling thread to `stats`
+// from now on, until it is called again; NULL stops counting. The counters
+// belong to the caller and are never reset by the scanner. A parser runs its
+// scanner on the thread that called ts_parser_parse, so this counts the
+// parses made on this thread in between, by any parser.
+void tree_sitter_bash_external_scanner_collect_stats(TSBashScannerStats *stats);
+
+// Returns the name of an external token, as indexed in `TSBashScannerStats`.
+const char *tree_sitter_bash_external_scanner_token_name(unsigned token);
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
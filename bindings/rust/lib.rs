@@ -42,11 +42,236 @@ pub const HIGHLIGHT_QUERY: &str = include_str!("../../queries/highlights.scm");
 
 #[cfg(test)]
 mod tests {
-    #[test]
-    fn test_can_load_grammar() {
+    fn parser() -> tree_sitter::Parser {
         let mut parser = tree_sitter::Parser::new();
         parser
             .set_language(&super::LANGUAGE.into())
             .expect("Error loading Bash parser");
+        parser
+    }
+
+    fn parse(code: impl AsRef<[u8]>) -> tree_sitter::Tree {
+        parser().parse(code, None).unwrap()
+    }
+
+    /// Parses `code`, handing it to the parser 64 bytes at a time, and returns
+    /// how many bytes the parser asked for. Going back over text it has read
+    /// before, whether to retry a scan or to find a column, makes it ask for
+    /// that text again, so this measures the lexing work without a clock.
+    fn bytes_read(code: &[u8]) -> usize {
+        let mut read = 0;
+        let tree = parser()
+            .parse_with_options(
+                &mut |offset, _| {
+                    let chunk = &code[offset.min(code.len())..(offset + 64).min(code.len())];
+                    read += chunk.len();
+                    chunk
+                },
+                None,
+                None,
+            )
+            .unwrap();
+        assert_eq!(tree.root_node().end_byte(), code.len());
+        read
+    }
+
+    #[test]
+    fn test_can_load_grammar() {
+        parser();
+    }
+
+    #[test]
+    fn test_long_heredoc_line() {
+        // A 1 MB single-line heredoc body, with an expansion every 64 KB. A
+        // 10 MB line makes the test slow in a debug build, so rather than
+        // relying on size, it checks that doubling the line about doubles the
+        // bytes the parser reads.
+        let chunk = format!("{}$x", "QUJD".repeat(16 * 1024));
+        let heredoc = |count| format!("cat <<EOF\n{}\nEOF\n", chunk.repeat(count));
+        let short = bytes_read(heredoc(8).as_bytes());
+        let long = bytes_read(heredoc(16).as_bytes());
+        assert!(long < short * 3, "{long} bytes read for 1 MB, {short} for 512 KB");
+
+        let code = heredoc(16);
+        let tree = parse(&code);
+        let root = tree.root_node();
+        assert!(!root.has_error());
+
+        let body = root.named_descendant_for_byte_range(20, 20).unwrap();
+        assert_eq!(body.kind(), "heredoc_body");
+        let mut cursor = body.walk();
+        let expansions = body
+            .named_children(&mut cursor)
+            .filter(|child| child.kind() == "simple_expansion")
+            .count();
+        assert_eq!(expansions, 16);
+    }
+
+    #[test]
+    fn test_long_heredoc_delimiter() {
+        // The first delimiter fits in the serialized scanner state; the second
+        // one doesn't and survives only as a prefix, which still ends the body
+        // on the delimiter line.
+        for length in [1016, 3000] {
+            let delimiter: String = ('A'..='Z').cycle().take(length).collect();
+            let code = format!("cat <<{delimiter}\nhello\n{delimiter}\necho done\n");
+            let tree = parse(&code);
+            let root = tree.root_node();
+            assert!(!root.has_error());
+            assert_eq!(root.named_child_count(), 2);
+
+            let end_start = code.len() - "\necho done\n".len() - length;
+            let end = root.named_descendant_for_byte_range(end_start, end_start).unwrap();
+            assert_eq!(end.kind(), "heredoc_end");
+            assert_eq!(end.utf8_text(code.as_bytes()).unwrap(), delimiter);
+        }
+    }
+
+    #[test]
+    fn test_unterminated_lookahead() {
+        // Each of these used to make the scanner read to the end of the input
+        // on every call, so that parsing them took quadratic time. At the
+        // sizes in test/lookahead, they are four times as long as the
+        // lookahead limit, and doubling one must about double the bytes read,
+        // not quadruple them.
+        let inputs: [(fn(usize) -> String, usize); 3] = [
+            (|n| "[[ $x =~ (foo|bar\n".repeat(n), 910),
+            (|n| format!("`{}", "echo no closing backtick\n".repeat(n)), 656),
+            (|n| format!("case $x in\n{}", "@(foo|bar".repeat(n)), 1820),
+        ];
+        for (input, count) in inputs {
+            let short = bytes_read(input(count).as_bytes());
+            let long = bytes_read(input(count * 2).as_bytes());
+            assert!(long < short * 3, "{long} bytes read for {:?}..., {short} for half of it", input(1));
+        }
+    }
+
+    #[test]
+    fn test_long_heredoc_body_chunks() {
+        // A long body comes back in several tokens, which still make up one
+        // `heredoc_body` that ends right before the delimiter, with the same
+        // nodes in it as if it had been scanned in one go.
+        for (line, expansions) in [
+            ("plain text\n", 0),
+            ("text with $var and ${var}\n", 2),
+            ("EO\n", 0),
+            ("\tE OF\n", 0),
+        ] {
+            let count = 100_000 / line.len();
+            let body = format!("{}{}", "x".repeat(50_000), line.repeat(count));
+            let code = format!("cat <<-EOF\n{body}EOF\necho done\n");
+            let tree = parse(&code);
+            let root = tree.root_node();
+            assert!(!root.has_error());
+            assert_eq!(root.named_child_count(), 2);
+
+            let redirect = root.child(0).unwrap().child_by_field_name("redirect").unwrap();
+            let heredoc_body = redirect.named_child(1).unwrap();
+            assert_eq!(heredoc_body.kind(), "heredoc_body");
+            assert_eq!(heredoc_body.end_byte(), code.len() - "EOF\necho done\n".len());
+            // Each expansion is followed by the text up to the next one, or
+            // up to the delimiter after the last one.
+            assert_eq!(heredoc_body.named_child_count(), count * expansions * 2);
+        }
+    }
+
+    #[test]
+    fn test_heredoc_edit_reuses_chunks() {
+        // After an edit inside a long heredoc body, reparsing only changes the
+        // chunks around the edit.
+        let body: String = (0..50_000).map(|i| format!("line {i}: value {}\n", i * 7)).collect();
+        let code = format!("cat <<EOF\n{body}EOF\n");
+        let mut parser = parser();
+        let mut tree = parser.parse(&code, None).unwrap();
+
+        let offset = code.len() / 2;
+        let mut edited = code.clone();
+        edited.insert(offset, 'x');
+        let position = |text: &str, offset: usize| {
+            let row = text[..offset].matches('\n').count();
+            let column = offset - text[..offset].rfind('\n').map_or(0, |i| i + 1);
+            tree_sitter::Point::new(row, column)
+        };
+        tree.edit(&tree_sitter::InputEdit {
+            start_byte: offset,
+            old_end_byte: offset,
+            new_end_byte: offset + 1,
+            start_position: position(&code, offset),
+            old_end_position: position(&code, offset),
+            new_end_position: position(&edited, offset + 1),
+        });
+
+        let new_tree = parser.parse(&edited, Some(&tree)).unwrap();
+        assert!(!new_tree.root_node().has_error());
+        let changed: usize = tree
+            .changed_ranges(&new_tree)
+            .map(|range| range.end_byte - range.start_byte)
+            .sum();
+        assert!(changed < 64 * 1024, "{changed} bytes changed");
+    }
+
+    #[test]
+    fn test_self_extracting_payload() {
+        // The data after a self-extracting script is a single `payload` node,
+        // and so is a raw heredoc body, even when either one spans several
+        // 16 KB scanner chunks.
+        let mut code = b"sed '1,/^exit 0$/d' \"$0\" | tar xz\nexit 0\n".to_vec();
+        code.extend([0x1f, 0x8b, 0x08, 0x00]);
+        code.extend((0..128 * 1024u32).map(|i| (i.wrapping_mul(2_654_435_761) >> 24) as u8));
+        let tree = parse(&code);
+        let root = tree.root_node();
+        assert!(!root.has_error());
+        assert_eq!(root.named_child_count(), 3);
+        let payload = root.named_child(2).unwrap();
+        assert_eq!(payload.kind(), "payload");
+        assert_eq!(payload.end_byte(), code.len());
+
+        let body = "H4sIAAAAAAAAA+3OMQqAMBBE0T3K$(echo) ${x}\n".repeat(3_000);
+        let code = format!("cat > archive.b64 <<'__ARCHIVE__'\n{body}__ARCHIVE__\nexit 0\n");
+        let tree = parse(&code);
+        let root = tree.root_node();
+        assert!(!root.has_error());
+        let redirect = root.child(0).unwrap().child_by_field_name("redirect").unwrap();
+        let heredoc_body = redirect.named_child(1).unwrap();
+        assert_eq!(heredoc_body.kind(), "heredoc_body");
+        assert_eq!(heredoc_body.named_child_count(), 0);
+    }
+
+    #[test]
+    fn test_unparsed_input() {
+        // Data with a NUL byte near the start is a single `unparsed_input`
+        // node, and so is data that is mostly binary without one, and a
+        // minified line of more than 64 KB. Shell with the odd control
+        // character or a long first line is parsed.
+        let mut zip = b"PK\x03\x04\x14\x00\x08\x00".to_vec();
+        zip.extend((0..100_000u32).map(|i| (i.wrapping_mul(2_654_435_761) >> 24) as u8));
+        let tree = parse(&zip);
+        let root = tree.root_node();
+        assert!(!root.has_error());
+        assert_eq!(root.named_child_count(), 1);
+        let input = root.named_child(0).unwrap();
+        assert_eq!(input.kind(), "unparsed_input");
+        assert_eq!(input.end_byte(), zip.len());
+
+        let mut packed = b"PK\x03\x04".to_vec();
+        packed.extend((0..30_000u32).map(|i| match (i.wrapping_mul(2_654_435_761) >> 24) as u8 {
+            0 | b'\n' => 0xff,
+            byte => byte,
+        }));
+        let minified = format!("!function(e){{{}}}", "var t=e.exports;".repeat(10_000));
+        for input in [&packed, minified.as_bytes()] {
+            let tree = parse(input);
+            let root = tree.root_node();
+            assert!(!root.has_error());
+            assert_eq!(root.named_child_count(), 1);
+            assert_eq!(root.named_child(0).unwrap().kind(), "unparsed_input");
+        }
+
+        let code = format!("X={}\nprintf '\x1b[1m%s\x1b[0m\\n' \"$1\"\n", "a".repeat(5_000));
+        let tree = parse(&code);
+        let root = tree.root_node();
+        assert!(!root.has_error());
+        assert_eq!(root.named_child_count(), 2);
+        assert_eq!(root.named_child(1).unwrap().kind(), "command");
     }
 }
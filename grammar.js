@@ -42,6 +42,25 @@ const PREC = {
   POSTFIX: 18,
 };
 
+// The binary operators that the expressions in tests, arithmetic and C-style
+// for loops have in common
+// https://tldp.org/LDP/abs/html/opprecedence.html
+const BINARY_OPERATORS = [
+  [choice('+=', '-=', '*=', '/=', '%=', '**=', '<<=', '>>=', '&=', '^=', '|='), PREC.UPDATE],
+  [choice('=', '=~'), PREC.ASSIGN],
+  ['||', PREC.LOGICAL_OR],
+  ['&&', PREC.LOGICAL_AND],
+  ['|', PREC.BITWISE_OR],
+  ['^', PREC.BITWISE_XOR],
+  ['&', PREC.BITWISE_AND],
+  [choice('==', '!='), PREC.EQUALITY],
+  [choice('<', '>', '<=', '>='), PREC.COMPARE],
+  [choice('<<', '>>'), PREC.SHIFT],
+  [choice('+', '-'), PREC.ADD],
+  [choice('*', '/', '%'), PREC.MULTIPLY],
+  ['**', PREC.EXPONENT],
+];
+
 module.exports = grammar({
   name: 'bash',
 
@@ -56,7 +75,6 @@ module.exports = grammar({
 
   inline: $ => [
     $._statement,
-    $._terminator,
     $._literal,
     $._terminated_statement,
     $._primary_expression,
@@ -92,11 +110,14 @@ module.exports = grammar({
     $._external_expansion_sym_equal,
     '}',
     ']',
-    '<<',
-    '<<-',
+    $._heredoc_arrow,
+    $._heredoc_arrow_dash,
     /\n/,
     '(',
-    'esac',
+    $._raw_heredoc_content,
+    $._payload_start,
+    $._payload_content,
+    $._script_start,
     $.__error_recovery,
   ],
 
@@ -116,7 +137,26 @@ module.exports = grammar({
   word: $ => $.word,
 
   rules: {
-    program: $ => optional($._statements),
+    program: $ => choice(
+      seq(
+        // Zero-width, after the scanner has checked the start of the input
+        // and found that it looks like shell
+        $._script_start,
+        optional($._statements),
+        // Data appended to a self-extracting script, such as a compressed
+        // archive
+        optional(alias($._opaque_data, $.payload)),
+      ),
+      // Input that the scanner judged not to be shell before parsing any of
+      // it: binary data with a NUL byte near the start, text full of control
+      // characters or a huge minified line
+      alias($._opaque_data, $.unparsed_input),
+    ),
+
+    _opaque_data: $ => seq(
+      $._payload_start,
+      repeat($._payload_content),
+    ),
 
     _statements: $ => prec(1, seq(
       repeat(seq(
@@ -249,40 +289,20 @@ module.exports = grammar({
       '=',
       field('value', $._c_expression),
     ),
+    // Only the increments: the for loop header has never had the other
+    // prefix operators or a ternary expression
     _c_unary_expression: $ => prec(PREC.PREFIX, seq(
       field('operator', choice('++', '--')),
       $._c_expression_not_assignment,
     )),
-    _c_binary_expression: $ => {
-      const table = [
-        [choice('+=', '-=', '*=', '/=', '%=', '**=', '<<=', '>>=', '&=', '^=', '|='), PREC.UPDATE],
-        [choice('||', '-o'), PREC.LOGICAL_OR],
-        [choice('&&', '-a'), PREC.LOGICAL_AND],
-        ['|', PREC.BITWISE_OR],
-        ['^', PREC.BITWISE_XOR],
-        ['&', PREC.BITWISE_AND],
-        [choice('==', '!='), PREC.EQUALITY],
-        [choice('<', '>', '<=', '>='), PREC.COMPARE],
-        [choice('<<', '>>'), PREC.SHIFT],
-        [choice('+', '-'), PREC.ADD],
-        [choice('*', '/', '%'), PREC.MULTIPLY],
-        ['**', PREC.EXPONENT],
-      ];
-
-      return choice(...table.map(([operator, precedence]) => {
-        // @ts-ignore
-        return prec[operator === '**' ? 'right' : 'left'](precedence, seq(
-          field('left', $._c_expression_not_assignment),
-          // @ts-ignore
-          field('operator', operator),
-          field('right', $._c_expression_not_assignment),
-        ));
-      }));
-    },
-    _c_postfix_expression: $ => prec(PREC.POSTFIX, seq(
-      $._c_expression_not_assignment,
-      field('operator', choice('++', '--')),
-    )),
+    // Assignments are variable_assignment nodes here, and `-o` and `-a` are
+    // accepted as `||` and `&&`
+    _c_binary_expression: $ => binaryExpression($._c_expression_not_assignment, [
+      ...BINARY_OPERATORS.filter(([, precedence]) => precedence !== PREC.ASSIGN),
+      ['-o', PREC.LOGICAL_OR],
+      ['-a', PREC.LOGICAL_AND],
+    ]),
+    _c_postfix_expression: $ => postfixExpression($._c_expression_not_assignment),
     _c_parenthesized_expression: $ => seq(
       '(',
       commaSep1($._c_expression),
@@ -541,7 +561,10 @@ module.exports = grammar({
 
     heredoc_redirect: $ => seq(
       field('descriptor', optional($.file_descriptor)),
-      choice('<<', '<<-'),
+      // Named, so that the arithmetic `<<` doesn't make the scanner look for
+      // heredocs in every arithmetic expression. The literals are for error
+      // recovery, where the scanner doesn't run.
+      choice(alias($._heredoc_arrow, '<<'), alias($._heredoc_arrow_dash, '<<-'), '<<', '<<-'),
       $.heredoc_start,
       optional(choice(
         alias($._heredoc_pipeline, $.pipeline),
@@ -580,6 +603,7 @@ module.exports = grammar({
         $.simple_expansion,
         $.command_substitution,
         $.heredoc_content,
+        $._raw_heredoc_content,
       )),
     ),
 
@@ -607,79 +631,28 @@ module.exports = grammar({
       $.parenthesized_expression,
     ),
 
-    // https://tldp.org/LDP/abs/html/opprecedence.html
-    binary_expression: $ => {
-      const table = [
-        [choice('+=', '-=', '*=', '/=', '%=', '**=', '<<=', '>>=', '&=', '^=', '|='), PREC.UPDATE],
-        [choice('=', '=~'), PREC.ASSIGN],
-        ['||', PREC.LOGICAL_OR],
-        ['&&', PREC.LOGICAL_AND],
-        ['|', PREC.BITWISE_OR],
-        ['^', PREC.BITWISE_XOR],
-        ['&', PREC.BITWISE_AND],
-        [choice('==', '!='), PREC.EQUALITY],
-        [choice('<', '>', '<=', '>='), PREC.COMPARE],
-        [$.test_operator, PREC.TEST],
-        [choice('<<', '>>'), PREC.SHIFT],
-        [choice('+', '-'), PREC.ADD],
-        [choice('*', '/', '%'), PREC.MULTIPLY],
-        ['**', PREC.EXPONENT],
-      ];
-
-      return choice(
-        choice(...table.map(([operator, precedence]) => {
-          // @ts-ignore
-          return prec[operator === '**' ? 'right' : 'left'](precedence, seq(
-            field('left', $._expression),
-            // @ts-ignore
-            field('operator', operator),
-            field('right', $._expression),
-          ));
-        })),
-        prec(PREC.ASSIGN, seq(
-          field('left', $._expression),
-          field('operator', '=~'),
-          field('right', alias($._regex_no_space, $.regex)),
-        )),
-        prec(PREC.EQUALITY, seq(
-          field('left', $._expression),
-          field('operator', choice('==', '!=')),
-          field('right', $._extglob_blob),
-        )),
-      );
-    },
-
-    ternary_expression: $ => prec.left(PREC.TERNARY, seq(
-      field('condition', $._expression),
-      '?',
-      field('consequence', $._expression),
-      ':',
-      field('alternative', $._expression),
-    )),
-
-    unary_expression: $ => choice(
-      prec(PREC.PREFIX, seq(
-        field('operator', tokenLiterals(1, '++', '--')),
-        $._expression,
-      )),
-      prec(PREC.UNARY, seq(
-        field('operator', tokenLiterals(1, '-', '+', '~')),
-        $._expression,
-      )),
-      prec.right(PREC.UNARY, seq(
-        field('operator', '!'),
-        $._expression,
+    binary_expression: $ => choice(
+      binaryExpression($._expression, [...BINARY_OPERATORS, [$.test_operator, PREC.TEST]]),
+      prec(PREC.ASSIGN, seq(
+        field('left', $._expression),
+        field('operator', '=~'),
+        field('right', alias($._regex_no_space, $.regex)),
       )),
-      prec.right(PREC.TEST, seq(
-        field('operator', $.test_operator),
-        $._expression,
+      prec(PREC.EQUALITY, seq(
+        field('left', $._expression),
+        field('operator', choice('==', '!=')),
+        field('right', $._extglob_blob),
       )),
     ),
 
-    postfix_expression: $ => prec(PREC.POSTFIX, seq(
+    ternary_expression: $ => ternaryExpression($._expression),
+
+    unary_expression: $ => unaryExpression($._expression, prec.right(PREC.TEST, seq(
+      field('operator', $.test_operator),
       $._expression,
-      field('operator', choice('++', '--')),
-    )),
+    ))),
+
+    postfix_expression: $ => postfixExpression($._expression),
 
     parenthesized_expression: $ => seq(
       '(',
@@ -745,61 +718,14 @@ module.exports = grammar({
       $.raw_string,
     )),
 
-    _arithmetic_binary_expression: $ => {
-      const table = [
-        [choice('+=', '-=', '*=', '/=', '%=', '**=', '<<=', '>>=', '&=', '^=', '|='), PREC.UPDATE],
-        [choice('=', '=~'), PREC.ASSIGN],
-        ['||', PREC.LOGICAL_OR],
-        ['&&', PREC.LOGICAL_AND],
-        ['|', PREC.BITWISE_OR],
-        ['^', PREC.BITWISE_XOR],
-        ['&', PREC.BITWISE_AND],
-        [choice('==', '!='), PREC.EQUALITY],
-        [choice('<', '>', '<=', '>='), PREC.COMPARE],
-        [choice('<<', '>>'), PREC.SHIFT],
-        [choice('+', '-'), PREC.ADD],
-        [choice('*', '/', '%'), PREC.MULTIPLY],
-        ['**', PREC.EXPONENT],
-      ];
-
-      return choice(...table.map(([operator, precedence]) => {
-        // @ts-ignore
-        return prec.left(precedence, seq(
-          field('left', $._arithmetic_expression),
-          // @ts-ignore
-          field('operator', operator),
-          field('right', $._arithmetic_expression),
-        ));
-      }));
-    },
+    // Unlike in the other contexts, `**` groups to the left here
+    _arithmetic_binary_expression: $ => binaryExpression($._arithmetic_expression, BINARY_OPERATORS, []),
 
-    _arithmetic_ternary_expression: $ => prec.left(PREC.TERNARY, seq(
-      field('condition', $._arithmetic_expression),
-      '?',
-      field('consequence', $._arithmetic_expression),
-      ':',
-      field('alternative', $._arithmetic_expression),
-    )),
+    _arithmetic_ternary_expression: $ => ternaryExpression($._arithmetic_expression),
 
-    _arithmetic_unary_expression: $ => choice(
-      prec(PREC.PREFIX, seq(
-        field('operator', tokenLiterals(1, '++', '--')),
-        $._arithmetic_expression,
-      )),
-      prec(PREC.UNARY, seq(
-        field('operator', tokenLiterals(1, '-', '+', '~')),
-        $._arithmetic_expression,
-      )),
-      prec.right(PREC.UNARY, seq(
-        field('operator', '!'),
-        $._arithmetic_expression,
-      )),
-    ),
+    _arithmetic_unary_expression: $ => unaryExpression($._arithmetic_expression),
 
-    _arithmetic_postfix_expression: $ => prec(PREC.POSTFIX, seq(
-      $._arithmetic_expression,
-      field('operator', choice('++', '--')),
-    )),
+    _arithmetic_postfix_expression: $ => postfixExpression($._arithmetic_expression),
 
     _arithmetic_parenthesized_expression: $ => seq(
       '(',
@@ -992,32 +918,26 @@ module.exports = grammar({
 
     _expansion_max_length: $ => seq(
       field('operator', ':'),
-      optional(choice(
-        $._simple_variable_name,
-        $.number,
-        $.arithmetic_expansion,
-        $.expansion,
-        $.parenthesized_expression,
-        $.command_substitution,
-        alias($._expansion_max_length_binary_expression, $.binary_expression),
-        /\n/,
-      )),
+      optional($._expansion_max_length_value),
       optional(seq(
         field('operator', ':'),
         optional($.simple_expansion),
-        optional(choice(
-          $._simple_variable_name,
-          $.number,
-          $.arithmetic_expansion,
-          $.expansion,
-          $.parenthesized_expression,
-          $.command_substitution,
-          alias($._expansion_max_length_binary_expression, $.binary_expression),
-          /\n/,
-        )),
+        optional($._expansion_max_length_value),
       )),
     ),
 
+    // The offset or the length in ${var:offset:length}
+    _expansion_max_length_value: $ => choice(
+      $._simple_variable_name,
+      $.number,
+      $.arithmetic_expansion,
+      $.expansion,
+      $.parenthesized_expression,
+      $.command_substitution,
+      alias($._expansion_max_length_binary_expression, $.binary_expression),
+      /\n/,
+    ),
+
     _expansion_max_length_expression: $ => choice(
       $._simple_variable_name,
       $.number,
@@ -1047,37 +967,27 @@ module.exports = grammar({
     ),
 
     _concatenation_in_expansion: $ => prec(-2, seq(
-      choice(
-        $.word,
-        $.variable_name,
-        $.simple_expansion,
-        $.expansion,
-        $.string,
-        $.raw_string,
-        $.ansi_c_string,
-        $.command_substitution,
-        alias($._expansion_word, $.word),
-        $.array,
-        $.process_substitution,
-      ),
+      $._concatenation_in_expansion_part,
       repeat1(seq(
         choice($._concat, alias(/`\s*`/, '``')),
-        choice(
-          $.word,
-          $.variable_name,
-          $.simple_expansion,
-          $.expansion,
-          $.string,
-          $.raw_string,
-          $.ansi_c_string,
-          $.command_substitution,
-          alias($._expansion_word, $.word),
-          $.array,
-          $.process_substitution,
-        ),
+        $._concatenation_in_expansion_part,
       )),
     )),
 
+    _concatenation_in_expansion_part: $ => choice(
+      $.word,
+      $.variable_name,
+      $.simple_expansion,
+      $.expansion,
+      $.string,
+      $.raw_string,
+      $.ansi_c_string,
+      $.command_substitution,
+      alias($._expansion_word, $.word),
+      $.array,
+      $.process_substitution,
+    ),
+
     command_substitution: $ => choice(
       seq('$(', $._statements, ')'),
       seq('$(', field('redirect', $.file_redirect), ')'),
@@ -1199,3 +1109,92 @@ function immediateLiterals(...literals) {
 function tokenLiterals(precedence, ...literals) {
   return choice(...literals.map(l => token(prec(precedence, l))));
 }
+
+// The builders below only share the source of the expression rules. Each
+// expression context calls them with its own operand and still gets its own
+// rules and parse states: the contexts accept different operators and
+// operands, so merging their rules would change what parses.
+
+/**
+ * Creates the binary expressions of one expression context, with the
+ * operators in `rightAssociative` right associative and every other operator
+ * left associative
+ *
+ * @param {RuleOrLiteral} operand
+ *
+ * @param {[RuleOrLiteral, number][]} operators pairs of operator and precedence
+ *
+ * @param {RuleOrLiteral[]} rightAssociative
+ *
+ * @returns {ChoiceRule}
+ */
+function binaryExpression(operand, operators, rightAssociative = ['**']) {
+  return choice(...operators.map(([operator, precedence]) => {
+    // @ts-ignore
+    return prec[rightAssociative.includes(operator) ? 'right' : 'left'](precedence, seq(
+      field('left', operand),
+      // @ts-ignore
+      field('operator', operator),
+      field('right', operand),
+    ));
+  }));
+}
+
+/**
+ * Creates the ternary expression of one expression context
+ *
+ * @param {RuleOrLiteral} operand
+ *
+ * @returns {PrecLeftRule}
+ */
+function ternaryExpression(operand) {
+  return prec.left(PREC.TERNARY, seq(
+    field('condition', operand),
+    '?',
+    field('consequence', operand),
+    ':',
+    field('alternative', operand),
+  ));
+}
+
+/**
+ * Creates the prefix expressions of one expression context, along with any
+ * that only that context has
+ *
+ * @param {RuleOrLiteral} operand
+ *
+ * @param {Rule[]} alternatives
+ *
+ * @returns {ChoiceRule}
+ */
+function unaryExpression(operand, ...alternatives) {
+  return choice(
+    prec(PREC.PREFIX, seq(
+      field('operator', tokenLiterals(1, '++', '--')),
+      operand,
+    )),
+    prec(PREC.UNARY, seq(
+      field('operator', tokenLiterals(1, '-', '+', '~')),
+      operand,
+    )),
+    prec.right(PREC.UNARY, seq(
+      field('operator', '!'),
+      operand,
+    )),
+    ...alternatives,
+  );
+}
+
+/**
+ * Creates the postfix expression of one expression context
+ *
+ * @param {RuleOrLiteral} operand
+ *
+ * @returns {PrecRule}
+ */
+function postfixExpression(operand) {
+  return prec(PREC.POSTFIX, seq(
+    operand,
+    field('operator', choice('++', '--')),
+  ));
+}
@@ -2,9 +2,14 @@
 #include "tree_sitter/parser.h"
 
 #include <assert.h>
-#include <ctype.h>
 #include <string.h>
-#include <wctype.h>
+
+#ifdef TREE_SITTER_BASH_STATS
+#include "tree_sitter/tree-sitter-bash.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#endif
 
 enum TokenType {
     HEREDOC_START,
@@ -34,18 +39,43 @@ enum TokenType {
     HEREDOC_ARROW_DASH,
     NEWLINE,
     OPENING_PAREN,
-    ESAC,
+    RAW_HEREDOC_CONTENT,
+    PAYLOAD_START,
+    PAYLOAD_CONTENT,
+    SCRIPT_START,
     ERROR_RECOVERY,
 };
 
-typedef Array(char) String;
+// Delimiters up to this size (including the terminating NUL) are stored
+// inline, so that the common case never touches the allocator.
+#define DELIMITER_INLINE_CAPACITY 24
+
+/**
+ * A heredoc delimiter, NUL-terminated. Short delimiters live in `inline_contents`;
+ * once one outgrows it, `capacity` exceeds `DELIMITER_INLINE_CAPACITY` and the
+ * contents move to `heap_contents`.
+ */
+typedef struct {
+    uint32_t size;
+    uint32_t capacity;
+    union {
+        char inline_contents[DELIMITER_INLINE_CAPACITY];
+        char *heap_contents;
+    };
+} Delimiter;
 
 typedef struct {
     bool is_raw;
     bool started;
     bool allows_indent;
-    String delimiter;
-    String current_leading_word;
+    // Set when only a prefix of the delimiter survived serialization; see
+    // `serialize`.
+    bool is_truncated;
+    // Set once the body has reached its first expansion. The text before it
+    // belongs to the hidden body beginning, so the chunks it is split into
+    // are hidden too; see `scan_heredoc_content`.
+    bool is_expanded;
+    Delimiter delimiter;
 } Heredoc;
 
 #define heredoc_new()                                                                                                  \
@@ -53,8 +83,9 @@ typedef struct {
         .is_raw = false,                                                                                               \
         .started = false,                                                                                              \
         .allows_indent = false,                                                                                        \
-        .delimiter = array_new(),                                                                                      \
-        .current_leading_word = array_new(),                                                                           \
+        .is_truncated = false,                                                                                         \
+        .is_expanded = false,                                                                                          \
+        .delimiter = {.size = 0, .capacity = DELIMITER_INLINE_CAPACITY},                                               \
     };
 
 typedef struct {
@@ -62,96 +93,547 @@ typedef struct {
     bool ext_was_in_double_quote;
     bool ext_saw_outside_quote;
     Array(Heredoc) heredocs;
+    // The serialized form of `heredocs`, as last written or restored, so that
+    // restoring the same heredocs again costs a comparison. It only holds
+    // while `heredoc_state_is_current` is set; scanning clears the flag as
+    // soon as it changes a heredoc.
+    bool heredoc_state_is_current;
+    uint32_t heredoc_state_length;
+    char heredoc_state[TREE_SITTER_SERIALIZATION_BUFFER_SIZE];
 } Scanner;
 
+/**
+ * Character classes for the ASCII range. Shell syntax is ASCII-delimited, and
+ * bash itself only treats these characters as blanks, digits and identifier
+ * characters, so anything outside of this table has no class. Unlike the
+ * `isw*` functions, this does not depend on the host's locale.
+ */
+enum {
+    CHAR_SPACE = 1 << 0,
+    CHAR_DIGIT = 1 << 1,
+    CHAR_ALPHA = 1 << 2,
+};
+
+static const uint8_t CHAR_CLASSES[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, CHAR_SPACE, CHAR_SPACE, CHAR_SPACE, CHAR_SPACE, CHAR_SPACE, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    CHAR_SPACE, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    CHAR_DIGIT, CHAR_DIGIT, CHAR_DIGIT, CHAR_DIGIT, CHAR_DIGIT, CHAR_DIGIT, CHAR_DIGIT, CHAR_DIGIT,
+    CHAR_DIGIT, CHAR_DIGIT, 0, 0, 0, 0, 0, 0,
+    0, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA,
+    CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA,
+    CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA,
+    CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, 0, 0, 0, 0, 0,
+    0, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA,
+    CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA,
+    CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA,
+    CHAR_ALPHA, CHAR_ALPHA, CHAR_ALPHA, 0, 0, 0, 0, 0,
+    // 0x80 - 0xff have no class
+};
+
+static inline bool char_is(int32_t c, uint8_t char_class) {
+    return (uint32_t)c < 256 && (CHAR_CLASSES[c] & char_class);
+}
+
+static inline bool is_space(int32_t c) { return char_is(c, CHAR_SPACE); }
+
+static inline bool is_digit(int32_t c) { return char_is(c, CHAR_DIGIT); }
+
+static inline bool is_alpha(int32_t c) { return char_is(c, CHAR_ALPHA); }
+
+static inline bool is_alnum(int32_t c) { return char_is(c, CHAR_ALPHA | CHAR_DIGIT); }
+
 static inline void advance(TSLexer *lexer) { lexer->advance(lexer, false); }
 
 static inline void skip(TSLexer *lexer) { lexer->advance(lexer, true); }
 
-static inline bool in_error_recovery(const bool *valid_symbols) { return valid_symbols[ERROR_RECOVERY]; }
+/**
+ * The valid tokens of a call to scan(), one bit per TokenType. scan() packs
+ * the runtime's array once, so that it can test for a whole group of tokens
+ * with a single mask instead of checking the array entry by entry.
+ */
+typedef uint64_t TokenSet;
+
+_Static_assert(ERROR_RECOVERY < 64, "TokenSet has a bit for every TokenType");
+
+#define TOKEN_BIT(token) ((TokenSet)1 << (token))
+
+// Gathers the low bit of each of the eight bytes of a little-endian word into
+// the top byte: byte i is shifted to bit 56 + i, and no two products overlap.
+#define GATHER_BYTE_BITS 0x0102040810204080ULL
+
+static inline TokenSet pack_bools(const bool *bools) {
+    uint64_t bytes;
+    memcpy(&bytes, bools, sizeof(bytes));
+    return (TokenSet)((bytes * GATHER_BYTE_BITS) >> 56);
+}
+
+static inline TokenSet token_set(const bool *valid_symbols) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // The runtime's bools are 0 or 1, so eight of them can be packed with one
+    // multiplication. The array ends at ERROR_RECOVERY, which is the last
+    // bit of the last read.
+    _Static_assert(ERROR_RECOVERY == 31, "token_set() reads exactly the valid tokens");
+    return pack_bools(valid_symbols) | pack_bools(valid_symbols + 8) << 8 | pack_bools(valid_symbols + 16) << 16 |
+           pack_bools(valid_symbols + 24) << 24;
+#else
+    TokenSet set = 0;
+    for (unsigned i = 0; i <= ERROR_RECOVERY; i++) {
+        set |= (TokenSet)valid_symbols[i] << i;
+    }
+    return set;
+#endif
+}
+
+static inline bool is_valid(TokenSet valid, enum TokenType token) { return valid & TOKEN_BIT(token); }
+
+static inline bool in_error_recovery(TokenSet valid) { return is_valid(valid, ERROR_RECOVERY); }
+
+// The groups of tokens that scan() dispatches on, in the order it tries them.
+// A call that can produce none of the tokens in a group skips all of its
+// checks at once.
+#define LEADING_TOKENS                                                                                                 \
+    (TOKEN_BIT(PAYLOAD_CONTENT) | TOKEN_BIT(CONCAT) | TOKEN_BIT(IMMEDIATE_DOUBLE_HASH) |                               \
+     TOKEN_BIT(EXTERNAL_EXPANSION_SYM_HASH) | TOKEN_BIT(EMPTY_VALUE) | TOKEN_BIT(SCRIPT_START))
+#define HEREDOC_TOKENS                                                                                                 \
+    (TOKEN_BIT(HEREDOC_BODY_BEGINNING) | TOKEN_BIT(SIMPLE_HEREDOC_BODY) | TOKEN_BIT(HEREDOC_END) |                     \
+     TOKEN_BIT(HEREDOC_CONTENT) | TOKEN_BIT(HEREDOC_START))
+#define WORD_TOKENS                                                                                                    \
+    (TOKEN_BIT(TEST_OPERATOR) | TOKEN_BIT(VARIABLE_NAME) | TOKEN_BIT(FILE_DESCRIPTOR) | TOKEN_BIT(HEREDOC_ARROW) |     \
+     TOKEN_BIT(BARE_DOLLAR) | TOKEN_BIT(REGEX) | TOKEN_BIT(REGEX_NO_SLASH) | TOKEN_BIT(REGEX_NO_SPACE) |               \
+     TOKEN_BIT(EXTGLOB_PATTERN) | TOKEN_BIT(EXPANSION_WORD) | TOKEN_BIT(BRACE_START))
+
+// The runtime only checks for cancellation and timeouts between tokens, so
+// these bound the work that a single call to the scanner can do. Both can be
+// overridden when compiling the parser.
+//
+// Scans whose outcome depends on a terminator that may never come (a closing
+// backtick, the end of a regex, an extglob pattern or an expansion word) give
+// up after this many characters, as if they had reached the end of the input.
+// The parser may retry them at many positions, and this keeps the total work
+// linear.
+//
+// The limit also applies to input that does have a terminator, so a token
+// that runs past it is not recognized: a regex, extglob pattern or expansion
+// word that long is an error, unless the lexer can read it as a plain word,
+// and a word isn't joined to a command substitution in backticks that long.
+// Raise the limit if your scripts need longer ones.
+#ifndef TREE_SITTER_BASH_LOOKAHEAD_LIMIT
+#define TREE_SITTER_BASH_LOOKAHEAD_LIMIT 4096
+#endif
+
+// A heredoc body that runs longer than this is returned in several tokens: a
+// body beginning followed by `heredoc_content` chunks. The payload of a
+// self-extracting script is split up the same way.
+#ifndef TREE_SITTER_BASH_HEREDOC_CHUNK_SIZE
+#define TREE_SITTER_BASH_HEREDOC_CHUNK_SIZE 16384
+#endif
+
+// Most chunks end well before that, at the end of a line that is picked by
+// the hash of its contents, with one line in `HEREDOC_CHUNK_LINES` picked on
+// average. As the boundaries depend on the text around them rather than on
+// where the scan began, the chunks after an edit line up with the old ones
+// again, and an incremental parse only has to scan the chunk that changed.
+#define HEREDOC_CHUNK_MIN_SIZE (TREE_SITTER_BASH_HEREDOC_CHUNK_SIZE / 16)
+#define HEREDOC_CHUNK_LINES 16
+
+// The chunks don't show up in the tree as long as they are hidden tokens,
+// which they are in a raw body and before the first expansion of any other
+// one. After that, the text between two expansions is a `heredoc_content`
+// node, which would be split in as many nodes as it takes chunks, so by
+// default it is scanned whole. When set, it is chunked as well: the work of
+// each call stays bounded, but the number of `heredoc_content` nodes then
+// depends on the length of the text.
+#ifndef TREE_SITTER_BASH_CHUNKED_HEREDOCS
+#define TREE_SITTER_BASH_CHUNKED_HEREDOCS 0
+#endif
+
+// When set, every heredoc body is scanned like the body of a heredoc with a
+// quoted delimiter: as plain text, without the `expansion`,
+// `simple_expansion` and `command_substitution` nodes inside it. Tools that
+// never look inside heredocs, like bulk indexers, can build the parser this
+// way to skip that work.
+#ifndef TREE_SITTER_BASH_SHALLOW_HEREDOCS
+#define TREE_SITTER_BASH_SHALLOW_HEREDOCS 0
+#endif
+
+// Before parsing anything, the scanner reads this many characters from the
+// start of the input, to tell shell apart from binary files that only have a
+// shell extension. Error recovery over those takes far longer than parsing a
+// real script. If the sample looks like shell, it is parsed as usual; if not,
+// the whole input becomes one `unparsed_input` node. A NUL byte always marks
+// the sample as binary, since no shell script contains one and bash refuses
+// to run a file that does. Zero turns the check off.
+#ifndef TREE_SITTER_BASH_INPUT_CHECK_SIZE
+#define TREE_SITTER_BASH_INPUT_CHECK_SIZE 4096
+#endif
+
+// The sample is not shell if more than this percentage of its characters can
+// only come from binary data, not counting a self-extracting script's
+// payload. Compressed data and executables are well over half binary, while
+// even a script that writes its terminal escapes out as raw bytes is far
+// below this. 100 turns this limit off.
+#ifndef TREE_SITTER_BASH_MAX_BINARY_PERCENT
+#define TREE_SITTER_BASH_MAX_BINARY_PERCENT 30
+#endif
+
+// The sample is not shell if it has a line at least this long, as minified
+// code does. The line that the sample ends in is read to its end or to this
+// length, so the limit can be longer than the sample. It is far above the
+// base64 and JSON assignments that scripts carry on one line, which `base64`
+// wraps at 76 characters unless told not to. Zero turns this limit off.
+#ifndef TREE_SITTER_BASH_MAX_LINE_LENGTH
+#define TREE_SITTER_BASH_MAX_LINE_LENGTH 65536
+#endif
+
+static inline bool delimiter_is_inline(const Delimiter *delimiter) {
+    return delimiter->capacity <= DELIMITER_INLINE_CAPACITY;
+}
+
+static inline char *delimiter_contents(Delimiter *delimiter) {
+    return delimiter_is_inline(delimiter) ? delimiter->inline_contents : delimiter->heap_contents;
+}
+
+static void delimiter_reserve(Delimiter *delimiter, uint32_t capacity) {
+    if (capacity <= delimiter->capacity) {
+        return;
+    }
+    if (capacity < 2 * delimiter->capacity) {
+        capacity = 2 * delimiter->capacity;
+    }
+    if (delimiter_is_inline(delimiter)) {
+        char *contents = ts_malloc(capacity);
+        memcpy(contents, delimiter->inline_contents, delimiter->size);
+        delimiter->heap_contents = contents;
+    } else {
+        delimiter->heap_contents = ts_realloc(delimiter->heap_contents, capacity);
+    }
+    delimiter->capacity = capacity;
+}
+
+static inline void delimiter_push(Delimiter *delimiter, char c) {
+    delimiter_reserve(delimiter, delimiter->size + 1);
+    delimiter_contents(delimiter)[delimiter->size++] = c;
+}
+
+/**
+ * Empties a delimiter. Its contents are always read up to `size`, so any
+ * heap storage is kept for reuse without being cleared.
+ */
+static inline void delimiter_clear(Delimiter *delimiter) { delimiter->size = 0; }
 
-static inline void reset_string(String *string) {
-    if (string->size > 0) {
-        memset(string->contents, 0, string->size);
-        array_clear(string);
+static inline void delimiter_delete(Delimiter *delimiter) {
+    if (!delimiter_is_inline(delimiter)) {
+        ts_free(delimiter->heap_contents);
     }
+    delimiter->size = 0;
+    delimiter->capacity = DELIMITER_INLINE_CAPACITY;
 }
 
 static inline void reset_heredoc(Heredoc *heredoc) {
     heredoc->is_raw = false;
     heredoc->started = false;
     heredoc->allows_indent = false;
-    reset_string(&heredoc->delimiter);
+    heredoc->is_truncated = false;
+    heredoc->is_expanded = false;
+    delimiter_clear(&heredoc->delimiter);
 }
 
-static inline void reset(Scanner *scanner) {
-    for (uint32_t i = 0; i < scanner->heredocs.size; i++) {
-        reset_heredoc(array_get(&scanner->heredocs, i));
+/**
+ * Serialized state layout. Integers are LEB128 varints.
+ *
+ *     varint  last_glob_paren_depth << 2 | ext_saw_outside_quote << 1 | ext_was_in_double_quote
+ *     varint  heredoc count, omitted when zero
+ *     per heredoc:
+ *         varint  value << 6 | HEREDOC_* flags
+ *         bytes   delimiter, without its NUL (only if not HEREDOC_REPEATED)
+ *
+ * For a literal delimiter, `value` is the number of bytes that follow; an
+ * empty delimiter has no bytes and no NUL. With HEREDOC_REPEATED, `value` is
+ * how many heredocs back the same delimiter was last written, so repeated
+ * `EOF`s cost one byte each.
+ *
+ * The initial state, with no glob depth, quote flags or heredocs, is empty.
+ * The runtime stores states of up to 24 bytes inline in the syntax tree, and
+ * a single pending heredoc with a delimiter of up to 20 bytes stays within
+ * that.
+ */
+enum {
+    HEREDOC_RAW = 1 << 0,
+    HEREDOC_STARTED = 1 << 1,
+    HEREDOC_ALLOWS_INDENT = 1 << 2,
+    HEREDOC_TRUNCATED = 1 << 3,
+    HEREDOC_EXPANDED = 1 << 4,
+    HEREDOC_REPEATED = 1 << 5,
+};
+
+#define HEREDOC_VALUE_SHIFT 6
+
+// How far back `serialize` looks for an identical delimiter to refer to.
+#define DELIMITER_REFERENCE_WINDOW 16
+
+// The largest encoding of a uint32_t varint.
+#define VARINT_MAX_SIZE 5
+
+/**
+ * Writes `value` as a varint and returns its size. With a NULL `buffer`, only
+ * measures it.
+ */
+static inline unsigned write_varint(char *buffer, uint32_t value) {
+    unsigned size = 0;
+    while (value >= 0x80) {
+        if (buffer) {
+            buffer[size] = (char)(value | 0x80);
+        }
+        size++;
+        value >>= 7;
     }
+    if (buffer) {
+        buffer[size] = (char)value;
+    }
+    return size + 1;
 }
 
-static unsigned serialize(Scanner *scanner, char *buffer) {
-    uint32_t size = 0;
-
-    buffer[size++] = (char)scanner->last_glob_paren_depth;
-    buffer[size++] = (char)scanner->ext_was_in_double_quote;
-    buffer[size++] = (char)scanner->ext_saw_outside_quote;
-    buffer[size++] = (char)scanner->heredocs.size;
+static inline uint32_t read_varint(const char *buffer, unsigned length, uint32_t *size) {
+    if (*size < length && (uint8_t)buffer[*size] < 0x80) {
+        return (uint8_t)buffer[(*size)++];
+    }
 
-    for (uint32_t i = 0; i < scanner->heredocs.size; i++) {
-        Heredoc *heredoc = array_get(&scanner->heredocs, i);
-        if (size + 3 + sizeof(uint32_t) + heredoc->delimiter.size >= TREE_SITTER_SERIALIZATION_BUFFER_SIZE) {
-            return 0;
+    uint32_t value = 0;
+    for (unsigned shift = 0; *size < length && shift < 7 * VARINT_MAX_SIZE; shift += 7) {
+        uint8_t byte = (uint8_t)buffer[(*size)++];
+        value |= (uint32_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            break;
         }
+    }
+    return value;
+}
 
-        buffer[size++] = (char)heredoc->is_raw;
-        buffer[size++] = (char)heredoc->started;
-        buffer[size++] = (char)heredoc->allows_indent;
+/**
+ * The number of delimiter bytes written for a heredoc when delimiters are
+ * clipped to `max_length` bytes.
+ */
+static inline uint32_t clipped_delimiter_length(Heredoc *heredoc, uint32_t max_length) {
+    uint32_t length = heredoc->delimiter.size > 0 ? heredoc->delimiter.size - 1 : 0;
+    return length < max_length ? length : max_length;
+}
 
-        memcpy(&buffer[size], &heredoc->delimiter.size, sizeof(uint32_t));
-        size += sizeof(uint32_t);
-        if (heredoc->delimiter.size > 0) {
-            memcpy(&buffer[size], heredoc->delimiter.contents, heredoc->delimiter.size);
-            size += heredoc->delimiter.size;
+/**
+ * Returns how many heredocs back from `index` the same clipped delimiter was
+ * written, or 0 if it has to be written out.
+ */
+static uint32_t find_repeated_delimiter(Scanner *scanner, uint32_t first, uint32_t index, uint32_t max_length) {
+    Heredoc *heredoc = array_get(&scanner->heredocs, index);
+    uint32_t length = clipped_delimiter_length(heredoc, max_length);
+    if (length == 0) {
+        return 0;
+    }
+    for (uint32_t distance = 1; distance <= DELIMITER_REFERENCE_WINDOW && distance <= index - first; distance++) {
+        Heredoc *other = array_get(&scanner->heredocs, index - distance);
+        if (clipped_delimiter_length(other, max_length) == length &&
+            memcmp(delimiter_contents(&heredoc->delimiter), delimiter_contents(&other->delimiter), length) == 0) {
+            return distance;
         }
     }
+    return 0;
+}
+
+static inline uint32_t state_header(Scanner *scanner) {
+    return (uint32_t)scanner->last_glob_paren_depth << 2 | (uint32_t)scanner->ext_saw_outside_quote << 1 |
+           (uint32_t)scanner->ext_was_in_double_quote;
+}
+
+/**
+ * Writes the heredoc at `index`, as part of a state that starts at `first`,
+ * with its delimiter clipped to `max_length` bytes, and returns its size.
+ * With a NULL `buffer`, only measures it.
+ */
+static uint32_t write_heredoc(Scanner *scanner, char *buffer, uint32_t first, uint32_t index, uint32_t max_length) {
+    Heredoc *heredoc = array_get(&scanner->heredocs, index);
+    uint32_t length = clipped_delimiter_length(heredoc, max_length);
+    uint32_t flags = (heredoc->is_raw ? HEREDOC_RAW : 0) | (heredoc->started ? HEREDOC_STARTED : 0) |
+                     (heredoc->allows_indent ? HEREDOC_ALLOWS_INDENT : 0) |
+                     (heredoc->is_expanded ? HEREDOC_EXPANDED : 0);
+    if (heredoc->is_truncated || (heredoc->delimiter.size > 0 && length < heredoc->delimiter.size - 1)) {
+        flags |= HEREDOC_TRUNCATED;
+    }
+
+    uint32_t distance = find_repeated_delimiter(scanner, first, index, max_length);
+    if (distance > 0) {
+        return write_varint(buffer, distance << HEREDOC_VALUE_SHIFT | flags | HEREDOC_REPEATED);
+    }
+
+    uint32_t size = write_varint(buffer, length << HEREDOC_VALUE_SHIFT | flags);
+    if (buffer && length > 0) {
+        memcpy(&buffer[size], delimiter_contents(&heredoc->delimiter), length);
+    }
+    return size + length;
+}
+
+/**
+ * Writes the state of the heredocs from `first` onwards, with delimiters
+ * clipped to `max_length` bytes, and returns its size. With a NULL `buffer`,
+ * only measures it.
+ */
+static uint32_t write_state(Scanner *scanner, char *buffer, uint32_t first, uint32_t max_length) {
+    uint32_t size = 0;
+    if (first == scanner->heredocs.size) {
+        return state_header(scanner) == 0 ? 0 : write_varint(buffer, state_header(scanner));
+    }
+    size += write_varint(buffer ? &buffer[size] : NULL, state_header(scanner));
+    size += write_varint(buffer ? &buffer[size] : NULL, scanner->heredocs.size - first);
+
+    for (uint32_t i = first; i < scanner->heredocs.size; i++) {
+        size += write_heredoc(scanner, buffer ? &buffer[size] : NULL, first, i, max_length);
+    }
     return size;
 }
 
-static void deserialize(Scanner *scanner, const char *buffer, unsigned length) {
-    if (length == 0) {
-        reset(scanner);
-    } else {
-        uint32_t size = 0;
-        scanner->last_glob_paren_depth = buffer[size++];
-        scanner->ext_was_in_double_quote = buffer[size++];
-        scanner->ext_saw_outside_quote = buffer[size++];
-        uint32_t heredoc_count = (unsigned char)buffer[size++];
-        for (uint32_t i = 0; i < heredoc_count; i++) {
-            Heredoc *heredoc = NULL;
-            if (i < scanner->heredocs.size) {
-                heredoc = array_get(&scanner->heredocs, i);
-            } else {
-                Heredoc new_heredoc = heredoc_new();
-                array_push(&scanner->heredocs, new_heredoc);
-                heredoc = array_back(&scanner->heredocs);
+/**
+ * Returns the outermost heredoc from which the stack still fits in the
+ * runtime's buffer with one-byte delimiters. The sizes are added up from the
+ * innermost heredoc outwards in a single pass: each heredoc taken in is
+ * written out in full, and the few after it that can now refer back to its
+ * delimiter instead of repeating it are measured again.
+ */
+static uint32_t first_kept_heredoc(Scanner *scanner) {
+    uint32_t count = scanner->heredocs.size;
+    uint32_t header_size = write_varint(NULL, state_header(scanner));
+    uint32_t heredocs_size = 0;
+    uint32_t first = count;
+
+    for (uint32_t i = count; i-- > 0;) {
+        heredocs_size += write_heredoc(scanner, NULL, i, i, 1);
+        for (uint32_t j = i + 1; j < count && j - i <= DELIMITER_REFERENCE_WINDOW; j++) {
+            if (find_repeated_delimiter(scanner, i, j, 1) == j - i) {
+                heredocs_size -= write_heredoc(scanner, NULL, i + 1, j, 1);
+                heredocs_size += write_heredoc(scanner, NULL, i, j, 1);
             }
+        }
+        if (header_size + write_varint(NULL, count - i) + heredocs_size <= TREE_SITTER_SERIALIZATION_BUFFER_SIZE) {
+            first = i;
+        }
+    }
+    return first;
+}
 
-            heredoc->is_raw = buffer[size++];
-            heredoc->started = buffer[size++];
-            heredoc->allows_indent = buffer[size++];
+/**
+ * Serializes the scanner state. If it doesn't fit in the runtime's buffer,
+ * it degrades in a defined way instead of being dropped: delimiters are cut
+ * to the longest common length that fits, and such a truncated delimiter
+ * ends its heredoc on any line that starts with the surviving prefix. If the
+ * stack is still too deep with one-byte delimiters, the outermost heredocs
+ * are dropped, since the innermost one is the one being read.
+ */
+static unsigned serialize(Scanner *scanner, char *buffer) {
+    if (write_state(scanner, NULL, 0, UINT32_MAX) <= TREE_SITTER_SERIALIZATION_BUFFER_SIZE) {
+        uint32_t size = write_state(scanner, buffer, 0, UINT32_MAX);
+        uint32_t header_size = size > 0 ? write_varint(NULL, state_header(scanner)) : 0;
+        scanner->heredoc_state_length = size - header_size;
+        memcpy(scanner->heredoc_state, &buffer[header_size], scanner->heredoc_state_length);
+        scanner->heredoc_state_is_current = true;
+        return size;
+    }
 
-            memcpy(&heredoc->delimiter.size, &buffer[size], sizeof(uint32_t));
-            size += sizeof(uint32_t);
-            array_reserve(&heredoc->delimiter, heredoc->delimiter.size);
+    scanner->heredoc_state_is_current = false;
 
-            if (heredoc->delimiter.size > 0) {
-                memcpy(heredoc->delimiter.contents, &buffer[size], heredoc->delimiter.size);
-                size += heredoc->delimiter.size;
-            }
+    uint32_t first = first_kept_heredoc(scanner);
+    uint32_t low = 1;
+    uint32_t high = TREE_SITTER_SERIALIZATION_BUFFER_SIZE;
+    while (low < high) {
+        uint32_t max_length = low + (high - low + 1) / 2;
+        if (write_state(scanner, NULL, first, max_length) <= TREE_SITTER_SERIALIZATION_BUFFER_SIZE) {
+            low = max_length;
+        } else {
+            high = max_length - 1;
         }
-        assert(size == length);
     }
+    return write_state(scanner, buffer, first, low);
+}
+
+/**
+ * Restores the heredoc stack from the heredoc part of a serialized state.
+ */
+static void deserialize_heredocs(Scanner *scanner, const char *buffer, unsigned length) {
+    uint32_t size = 0;
+    uint32_t heredoc_count = read_varint(buffer, length, &size);
+    for (uint32_t i = 0; i < heredoc_count; i++) {
+        Heredoc *heredoc = NULL;
+        if (i < scanner->heredocs.size) {
+            heredoc = array_get(&scanner->heredocs, i);
+        } else {
+            Heredoc new_heredoc = heredoc_new();
+            array_push(&scanner->heredocs, new_heredoc);
+            heredoc = array_back(&scanner->heredocs);
+        }
+
+        uint32_t value = read_varint(buffer, length, &size);
+        uint32_t flags = value & ((1 << HEREDOC_VALUE_SHIFT) - 1);
+        value >>= HEREDOC_VALUE_SHIFT;
+        heredoc->is_raw = flags & HEREDOC_RAW;
+        heredoc->started = flags & HEREDOC_STARTED;
+        heredoc->allows_indent = flags & HEREDOC_ALLOWS_INDENT;
+        heredoc->is_truncated = flags & HEREDOC_TRUNCATED;
+        heredoc->is_expanded = flags & HEREDOC_EXPANDED;
+
+        const char *delimiter;
+        uint32_t delimiter_length;
+        if (flags & HEREDOC_REPEATED) {
+            assert(value > 0 && value <= i);
+            Heredoc *other = array_get(&scanner->heredocs, i - value);
+            delimiter = delimiter_contents(&other->delimiter);
+            delimiter_length = other->delimiter.size > 0 ? other->delimiter.size - 1 : 0;
+        } else {
+            assert(size + value <= length);
+            delimiter = &buffer[size];
+            delimiter_length = value;
+            size += value;
+        }
+
+        delimiter_clear(&heredoc->delimiter);
+        if (delimiter_length > 0 || (flags & HEREDOC_REPEATED)) {
+            delimiter_reserve(&heredoc->delimiter, delimiter_length + 1);
+            char *contents = delimiter_contents(&heredoc->delimiter);
+            memcpy(contents, delimiter, delimiter_length);
+            contents[delimiter_length] = '\0';
+            heredoc->delimiter.size = delimiter_length + 1;
+        }
+    }
+    assert(size == length);
+
+    for (uint32_t i = heredoc_count; i < scanner->heredocs.size; i++) {
+        delimiter_delete(&array_get(&scanner->heredocs, i)->delimiter);
+    }
+    scanner->heredocs.size = heredoc_count;
+}
+
+static void deserialize(Scanner *scanner, const char *buffer, unsigned length) {
+    uint32_t size = 0;
+    uint32_t header = length > 0 ? read_varint(buffer, length, &size) : 0;
+    scanner->last_glob_paren_depth = (uint8_t)(header >> 2);
+    scanner->ext_saw_outside_quote = header & 2;
+    scanner->ext_was_in_double_quote = header & 1;
+
+    const char *heredoc_state = length > 0 ? &buffer[size] : "";
+    uint32_t heredoc_state_length = length - size;
+
+    // Most scripts have no heredocs at all.
+    if (heredoc_state_length == 0 && scanner->heredocs.size == 0) {
+        return;
+    }
+    if (scanner->heredoc_state_is_current && heredoc_state_length == scanner->heredoc_state_length &&
+        memcmp(heredoc_state, scanner->heredoc_state, heredoc_state_length) == 0) {
+        return;
+    }
+
+    deserialize_heredocs(scanner, heredoc_state, heredoc_state_length);
+    memcpy(scanner->heredoc_state, heredoc_state, heredoc_state_length);
+    scanner->heredoc_state_length = heredoc_state_length;
+    scanner->heredoc_state_is_current = true;
 }
 
 /**
@@ -161,7 +643,7 @@ static void deserialize(Scanner *scanner, const char *buffer, unsigned length) {
  * POSIX-mandated substitution, and assumes the default value for
  * IFS.
  */
-static bool advance_word(TSLexer *lexer, String *unquoted_word) {
+static bool advance_word(TSLexer *lexer, Delimiter *unquoted_word) {
     bool empty = true;
 
     int32_t quote = 0;
@@ -172,7 +654,7 @@ static bool advance_word(TSLexer *lexer, String *unquoted_word) {
 
     while (lexer->lookahead &&
            !(quote ? lexer->lookahead == quote || lexer->lookahead == '\r' || lexer->lookahead == '\n'
-                   : iswspace(lexer->lookahead))) {
+                   : is_space(lexer->lookahead))) {
         if (lexer->lookahead == '\\') {
             advance(lexer);
             if (!lexer->lookahead) {
@@ -180,10 +662,10 @@ static bool advance_word(TSLexer *lexer, String *unquoted_word) {
             }
         }
         empty = false;
-        array_push(unquoted_word, lexer->lookahead);
+        delimiter_push(unquoted_word, (char)lexer->lookahead);
         advance(lexer);
     }
-    array_push(unquoted_word, '\0');
+    delimiter_push(unquoted_word, '\0');
 
     if (quote && lexer->lookahead == quote) {
         advance(lexer);
@@ -193,7 +675,7 @@ static bool advance_word(TSLexer *lexer, String *unquoted_word) {
 }
 
 static inline bool scan_bare_dollar(TSLexer *lexer) {
-    while (iswspace(lexer->lookahead) && lexer->lookahead != '\n' && !lexer->eof(lexer)) {
+    while (is_space(lexer->lookahead) && lexer->lookahead != '\n' && !lexer->eof(lexer)) {
         skip(lexer);
     }
 
@@ -201,46 +683,90 @@ static inline bool scan_bare_dollar(TSLexer *lexer) {
         advance(lexer);
         lexer->result_symbol = BARE_DOLLAR;
         lexer->mark_end(lexer);
-        return iswspace(lexer->lookahead) || lexer->eof(lexer) || lexer->lookahead == '\"';
+        return is_space(lexer->lookahead) || lexer->eof(lexer) || lexer->lookahead == '\"';
     }
 
     return false;
 }
 
 static bool scan_heredoc_start(Heredoc *heredoc, TSLexer *lexer) {
-    while (iswspace(lexer->lookahead)) {
+    while (is_space(lexer->lookahead)) {
         skip(lexer);
     }
 
     lexer->result_symbol = HEREDOC_START;
-    heredoc->is_raw = lexer->lookahead == '\'' || lexer->lookahead == '"' || lexer->lookahead == '\\';
+    heredoc->is_raw = TREE_SITTER_BASH_SHALLOW_HEREDOCS || lexer->lookahead == '\'' || lexer->lookahead == '"' ||
+                      lexer->lookahead == '\\';
+    heredoc->is_truncated = false;
+    heredoc->is_expanded = false;
 
     bool found_delimiter = advance_word(lexer, &heredoc->delimiter);
     if (!found_delimiter) {
-        reset_string(&heredoc->delimiter);
+        delimiter_clear(&heredoc->delimiter);
         return false;
     }
     return found_delimiter;
 }
 
-static bool scan_heredoc_end_identifier(Heredoc *heredoc, TSLexer *lexer) {
-    reset_string(&heredoc->current_leading_word);
-    // Scan the first 'n' characters on this line, to see if they match the
-    // heredoc delimiter
-    int32_t size = 0;
-    if (heredoc->delimiter.size > 0) {
-        while (lexer->lookahead != '\0' && lexer->lookahead != '\n' &&
-               (int32_t)*array_get(&heredoc->delimiter, size) == lexer->lookahead &&
-               heredoc->current_leading_word.size < heredoc->delimiter.size) {
-            array_push(&heredoc->current_leading_word, lexer->lookahead);
+/**
+ * Consumes the longest prefix of the current line that matches the heredoc's
+ * delimiter, comparing in place, and returns its length.
+ */
+static uint32_t advance_delimiter_prefix(Heredoc *heredoc, TSLexer *lexer) {
+    const char *delimiter = delimiter_contents(&heredoc->delimiter);
+    uint32_t size = 0;
+    while (size < heredoc->delimiter.size && lexer->lookahead != '\0' && lexer->lookahead != '\n' &&
+           (int32_t)delimiter[size] == lexer->lookahead) {
+        advance(lexer);
+        size++;
+    }
+    return size;
+}
+
+/**
+ * Checks whether a line prefix of `prefix_size` characters, as consumed by
+ * `advance_delimiter_prefix`, ends the heredoc.
+ */
+static bool is_delimiter_match(Heredoc *heredoc, TSLexer *lexer, uint32_t prefix_size) {
+    if (prefix_size >= heredoc->delimiter.size || delimiter_contents(&heredoc->delimiter)[prefix_size] != '\0') {
+        return false;
+    }
+    if (heredoc->is_truncated) {
+        // The rest of the delimiter was lost in serialization, so the rest of
+        // the line stands in for it.
+        while (lexer->lookahead != '\0' && lexer->lookahead != '\n') {
             advance(lexer);
-            size++;
         }
     }
-    array_push(&heredoc->current_leading_word, '\0');
-    return heredoc->delimiter.size == 0
-               ? false
-               : strcmp(heredoc->current_leading_word.contents, heredoc->delimiter.contents) == 0;
+    return true;
+}
+
+static bool scan_heredoc_end_identifier(Heredoc *heredoc, TSLexer *lexer) {
+    return is_delimiter_match(heredoc, lexer, advance_delimiter_prefix(heredoc, lexer));
+}
+
+/**
+ * Advances within a heredoc body, keeping track of whether the lexer is at
+ * the start of a line.
+ */
+static inline void advance_heredoc(TSLexer *lexer, bool skip, bool *at_line_start) {
+    *at_line_start = lexer->lookahead == '\n';
+    lexer->advance(lexer, skip);
+}
+
+/**
+ * Checks whether a heredoc body can be split into two tokens before the
+ * current character, such that the scan for the second one picks up exactly
+ * where the first one ended.
+ */
+static inline bool is_heredoc_chunk_boundary(Heredoc *heredoc, TSLexer *lexer, bool at_line_start) {
+    // The `HEREDOC_END` scan, which runs before `HEREDOC_CONTENT`, takes any
+    // text that starts like the delimiter for the end of the heredoc. A `$`
+    // only starts a token when it starts an expansion. And at the start of a
+    // line, the body could end.
+    int32_t first = (unsigned char)delimiter_contents(&heredoc->delimiter)[0];
+    return !at_line_start && first != '\0' && lexer->lookahead != first && lexer->lookahead != '$' &&
+           !lexer->eof(lexer);
 }
 
 static bool scan_heredoc_content(Scanner *scanner, TSLexer *lexer, enum TokenType middle_type,
@@ -248,11 +774,29 @@ static bool scan_heredoc_content(Scanner *scanner, TSLexer *lexer, enum TokenTyp
     bool did_advance = false;
     Heredoc *heredoc = array_back(&scanner->heredocs);
 
+    // A body that hasn't started yet begins right after the newline that
+    // ends the heredoc's command, and a started body only resumes after an
+    // expansion, so we know whether we're at the start of a line without
+    // asking the lexer for the column, which costs O(column) in the runtime.
+    bool at_line_start = !heredoc->started;
+    bool may_chunk = TREE_SITTER_BASH_CHUNKED_HEREDOCS || !heredoc->is_expanded;
+    uint32_t scanned = 0;
+    uint32_t line_hash = 0;
+
     for (;;) {
+        if (++scanned > TREE_SITTER_BASH_HEREDOC_CHUNK_SIZE && may_chunk && did_advance &&
+            is_heredoc_chunk_boundary(heredoc, lexer, at_line_start)) {
+            lexer->mark_end(lexer);
+            lexer->result_symbol = middle_type;
+            heredoc->started = true;
+            return true;
+        }
+
         switch (lexer->lookahead) {
             case '\0': {
                 if (lexer->eof(lexer) && did_advance) {
                     reset_heredoc(heredoc);
+                    lexer->mark_end(lexer);
                     lexer->result_symbol = end_type;
                     return true;
                 }
@@ -261,71 +805,86 @@ static bool scan_heredoc_content(Scanner *scanner, TSLexer *lexer, enum TokenTyp
 
             case '\\': {
                 did_advance = true;
-                advance(lexer);
-                advance(lexer);
+                advance_heredoc(lexer, false, &at_line_start);
+                advance_heredoc(lexer, false, &at_line_start);
                 break;
             }
 
             case '$': {
                 if (heredoc->is_raw) {
                     did_advance = true;
-                    advance(lexer);
+                    advance_heredoc(lexer, false, &at_line_start);
                     break;
                 }
                 if (did_advance) {
                     lexer->mark_end(lexer);
                     lexer->result_symbol = middle_type;
                     heredoc->started = true;
-                    advance(lexer);
-                    if (iswalpha(lexer->lookahead) || lexer->lookahead == '{' || lexer->lookahead == '(') {
+                    advance_heredoc(lexer, false, &at_line_start);
+                    if (is_alpha(lexer->lookahead) || lexer->lookahead == '{' || lexer->lookahead == '(') {
+                        heredoc->is_expanded = true;
                         return true;
                     }
                     break;
                 }
-                if (middle_type == HEREDOC_BODY_BEGINNING && lexer->get_column(lexer) == 0) {
+                if (middle_type == HEREDOC_BODY_BEGINNING && at_line_start) {
                     lexer->result_symbol = middle_type;
                     heredoc->started = true;
+                    heredoc->is_expanded = true;
                     return true;
                 }
                 return false;
             }
 
             case '\n': {
-                if (!did_advance) {
-                    skip(lexer);
-                } else {
-                    advance(lexer);
+                if (scanned > HEREDOC_CHUNK_MIN_SIZE && line_hash % HEREDOC_CHUNK_LINES == 0 && may_chunk &&
+                    did_advance && is_heredoc_chunk_boundary(heredoc, lexer, at_line_start)) {
+                    lexer->mark_end(lexer);
+                    lexer->result_symbol = middle_type;
+                    heredoc->started = true;
+                    return true;
                 }
+                line_hash = 0;
+                advance_heredoc(lexer, !did_advance, &at_line_start);
                 did_advance = true;
                 if (heredoc->allows_indent) {
-                    while (iswspace(lexer->lookahead)) {
-                        advance(lexer);
+                    while (is_space(lexer->lookahead)) {
+                        advance_heredoc(lexer, false, &at_line_start);
                     }
                 }
                 lexer->result_symbol = heredoc->started ? middle_type : end_type;
                 lexer->mark_end(lexer);
-                if (scan_heredoc_end_identifier(heredoc, lexer)) {
+                uint32_t prefix_size = advance_delimiter_prefix(heredoc, lexer);
+                if (is_delimiter_match(heredoc, lexer, prefix_size)) {
                     if (lexer->result_symbol == HEREDOC_END) {
+                        delimiter_delete(&heredoc->delimiter);
                         array_pop(&scanner->heredocs);
                     }
                     return true;
                 }
+                if (prefix_size > 0) {
+                    at_line_start = false;
+                }
                 break;
             }
 
             default: {
-                if (lexer->get_column(lexer) == 0) {
-                    // an alternative is to check the starting column of the
-                    // heredoc body and track that statefully
-                    while (iswspace(lexer->lookahead)) {
-                        if (did_advance) {
-                            advance(lexer);
-                        } else {
-                            skip(lexer);
-                        }
+                if (at_line_start) {
+                    // A line that follows an escaped newline hasn't been marked
+                    // yet. The content before a delimiter has to end where the
+                    // `HEREDOC_END` scan can pick it up, which is past the
+                    // indentation only if the delimiter may be indented.
+                    if (end_type != SIMPLE_HEREDOC_BODY && !heredoc->allows_indent) {
+                        lexer->mark_end(lexer);
+                    }
+                    while (is_space(lexer->lookahead)) {
+                        advance_heredoc(lexer, !did_advance, &at_line_start);
                     }
                     if (end_type != SIMPLE_HEREDOC_BODY) {
                         lexer->result_symbol = middle_type;
+                        if (heredoc->allows_indent) {
+                            lexer->mark_end(lexer);
+                        }
                         if (scan_heredoc_end_identifier(heredoc, lexer)) {
                             return true;
                         }
@@ -338,21 +897,156 @@ static bool scan_heredoc_content(Scanner *scanner, TSLexer *lexer, enum TokenTyp
                         }
                     }
                 }
+                line_hash = line_hash * 31 + (uint32_t)lexer->lookahead;
                 did_advance = true;
-                advance(lexer);
+                advance_heredoc(lexer, false, &at_line_start);
                 break;
             }
         }
     }
 }
 
+/**
+ * Checks whether the lookahead can only come from binary data, like the
+ * compressed archive that a self-extracting script carries after its last
+ * command: an invalid byte, or an ASCII control character that isn't a blank.
+ */
+static inline bool is_binary(TSLexer *lexer) {
+    int32_t c = lexer->lookahead;
+    return c < 0 || c == 0x7f || (c < ' ' && !is_space(c) && !(c == '\0' && lexer->eof(lexer)));
+}
+
+/**
+ * Scans the payload of a self-extracting script, which runs to the end of the
+ * input, without looking at the bytes. Like a heredoc body, a large payload
+ * takes several tokens, so that each call does a bounded amount of work.
+ */
+static bool scan_payload(TSLexer *lexer, enum TokenType symbol) {
+    for (uint32_t scanned = 0; scanned < TREE_SITTER_BASH_HEREDOC_CHUNK_SIZE && !lexer->eof(lexer); scanned++) {
+        advance(lexer);
+    }
+    lexer->mark_end(lexer);
+    lexer->result_symbol = symbol;
+    return true;
+}
+
+static inline bool is_long_line(uint32_t length) {
+#if TREE_SITTER_BASH_MAX_LINE_LENGTH > 0
+    return length >= TREE_SITTER_BASH_MAX_LINE_LENGTH;
+#else
+    (void)length;
+    return false;
+#endif
+}
+
+/**
+ * Checks the start of the input, before the first token, against the limits
+ * above. A binary character at the start of a line ends the sample: a
+ * self-extracting script's payload can begin there, and the statements before
+ * it are still worth parsing. Either way, this reads the sample only once per
+ * parse, as SCRIPT_START is valid nowhere else. Leading whitespace is skipped
+ * first, so that it stays padding and the tree starts where it used to.
+ */
+static bool scan_script_start(TSLexer *lexer) {
+    while (is_space(lexer->lookahead)) {
+        skip(lexer);
+    }
+    lexer->mark_end(lexer);
+
+    uint32_t sampled = 0;
+    uint32_t binary = 0;
+    uint32_t line_length = 0;
+    bool has_nul = false;
+    // Past the sample, carry on to the end of the line it ended in, so that
+    // a long line is seen whole.
+    while ((sampled < TREE_SITTER_BASH_INPUT_CHECK_SIZE || (TREE_SITTER_BASH_MAX_LINE_LENGTH > 0 && line_length > 0)) &&
+           !is_long_line(line_length) && (lexer->lookahead != 0 || !lexer->eof(lexer))) {
+        if (lexer->lookahead == '\n') {
+            line_length = 0;
+        } else if (is_binary(lexer)) {
+            if (line_length == 0) {
+                break;
+            }
+            has_nul = has_nul || lexer->lookahead == 0;
+            binary++;
+            line_length++;
+        } else {
+            line_length++;
+        }
+        advance(lexer);
+        sampled++;
+    }
+
+    if (has_nul || is_long_line(line_length) ||
+        (uint64_t)binary * 100 > (uint64_t)sampled * TREE_SITTER_BASH_MAX_BINARY_PERCENT) {
+        // The sample is the first chunk of the unparsed input.
+        lexer->mark_end(lexer);
+        lexer->result_symbol = PAYLOAD_START;
+        return true;
+    }
+    lexer->result_symbol = SCRIPT_START;
+    return true;
+}
+
+/**
+ * Scans the rest of a word at the start of a top-level statement, after its
+ * first character, an underscore. If the word is on a line of its own and
+ * looks like the `__ARCHIVE_BELOW__` markers that self-extracting scripts and
+ * shar archives put before their payload, the rest of the input is the
+ * payload. Otherwise, this stops right after the word.
+ */
+static bool scan_payload_marker(TSLexer *lexer) {
+    uint32_t length = 1;
+    uint32_t leading_underscores = 0;
+    uint32_t trailing_underscores = 1;
+    bool is_upper_case = true;
+    while (is_alnum(lexer->lookahead) || lexer->lookahead == '_') {
+        if (lexer->lookahead == '_') {
+            trailing_underscores++;
+        } else {
+            if (trailing_underscores == length) {
+                leading_underscores = length;
+            }
+            trailing_underscores = 0;
+            is_upper_case = is_upper_case && !(lexer->lookahead >= 'a' && lexer->lookahead <= 'z');
+        }
+        length++;
+        advance(lexer);
+    }
+
+    if (leading_underscores >= 2 && trailing_underscores >= 2 && is_upper_case &&
+        (lexer->lookahead == '\n' || lexer->lookahead == '\r' || lexer->eof(lexer))) {
+        return scan_payload(lexer, PAYLOAD_START);
+    }
+    return false;
+}
+
 static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
-    if (valid_symbols[CONCAT] && !in_error_recovery(valid_symbols)) {
-        if (!(lexer->lookahead == 0 || iswspace(lexer->lookahead) || lexer->lookahead == '>' ||
+    TokenSet valid = token_set(valid_symbols);
+
+    // Most calls come from states where only the word tokens at the end are
+    // valid, or only a heredoc body is.
+    if (!(valid & LEADING_TOKENS)) {
+        if (valid & HEREDOC_TOKENS) {
+            goto heredoc;
+        }
+        goto word;
+    }
+
+    if (is_valid(valid, SCRIPT_START) && !in_error_recovery(valid)) {
+        return scan_script_start(lexer);
+    }
+
+    if (is_valid(valid, PAYLOAD_CONTENT) && !in_error_recovery(valid)) {
+        return !lexer->eof(lexer) && scan_payload(lexer, PAYLOAD_CONTENT);
+    }
+
+    if (is_valid(valid, CONCAT) && !in_error_recovery(valid)) {
+        if (!(lexer->lookahead == 0 || is_space(lexer->lookahead) || lexer->lookahead == '>' ||
               lexer->lookahead == '<' || lexer->lookahead == ')' || lexer->lookahead == '(' ||
               lexer->lookahead == ';' || lexer->lookahead == '&' || lexer->lookahead == '|' ||
-              (lexer->lookahead == '}' && valid_symbols[CLOSING_BRACE]) ||
-              (lexer->lookahead == ']' && valid_symbols[CLOSING_BRACKET]))) {
+              (lexer->lookahead == '}' && is_valid(valid, CLOSING_BRACE)) ||
+              (lexer->lookahead == ']' && is_valid(valid, CLOSING_BRACKET)))) {
             lexer->result_symbol = CONCAT;
             // So for a`b`, we want to return a concat. We check if the
             // 2nd backtick has whitespace after it, and if it does we
@@ -360,7 +1054,11 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
             if (lexer->lookahead == '`') {
                 lexer->mark_end(lexer);
                 advance(lexer);
+                uint32_t lookahead = 0;
                 while (lexer->lookahead != '`' && !lexer->eof(lexer)) {
+                    if (++lookahead > TREE_SITTER_BASH_LOOKAHEAD_LIMIT) {
+                        return false;
+                    }
                     advance(lexer);
                 }
                 if (lexer->eof(lexer)) {
@@ -369,7 +1067,7 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
                 if (lexer->lookahead == '`') {
                     advance(lexer);
                 }
-                return iswspace(lexer->lookahead) || lexer->eof(lexer);
+                return is_space(lexer->lookahead) || lexer->eof(lexer);
             }
             // strings w/ expansions that contains escaped quotes or
             // backslashes need this to return a concat
@@ -386,13 +1084,13 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
                 return true;
             }
         }
-        if (iswspace(lexer->lookahead) && valid_symbols[CLOSING_BRACE] && !valid_symbols[EXPANSION_WORD]) {
+        if (is_space(lexer->lookahead) && is_valid(valid, CLOSING_BRACE) && !is_valid(valid, EXPANSION_WORD)) {
             lexer->result_symbol = CONCAT;
             return true;
         }
     }
 
-    if (valid_symbols[IMMEDIATE_DOUBLE_HASH] && !in_error_recovery(valid_symbols)) {
+    if (is_valid(valid, IMMEDIATE_DOUBLE_HASH) && !in_error_recovery(valid)) {
         // advance two # and ensure not } after
         if (lexer->lookahead == '#') {
             lexer->mark_end(lexer);
@@ -408,7 +1106,7 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
         }
     }
 
-    if (valid_symbols[EXTERNAL_EXPANSION_SYM_HASH] && !in_error_recovery(valid_symbols)) {
+    if (is_valid(valid, EXTERNAL_EXPANSION_SYM_HASH) && !in_error_recovery(valid)) {
         if (lexer->lookahead == '#' || lexer->lookahead == '=' || lexer->lookahead == '!') {
             lexer->result_symbol = lexer->lookahead == '#'   ? EXTERNAL_EXPANSION_SYM_HASH
                                    : lexer->lookahead == '!' ? EXTERNAL_EXPANSION_SYM_BANG
@@ -418,7 +1116,7 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
             while (lexer->lookahead == '#' || lexer->lookahead == '=' || lexer->lookahead == '!') {
                 advance(lexer);
             }
-            while (iswspace(lexer->lookahead)) {
+            while (is_space(lexer->lookahead)) {
                 skip(lexer);
             }
             if (lexer->lookahead == '}') {
@@ -428,48 +1126,67 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
         }
     }
 
-    if (valid_symbols[EMPTY_VALUE]) {
-        if (iswspace(lexer->lookahead) || lexer->eof(lexer) || lexer->lookahead == ';' || lexer->lookahead == '&') {
+    if (is_valid(valid, EMPTY_VALUE)) {
+        if (is_space(lexer->lookahead) || lexer->eof(lexer) || lexer->lookahead == ';' || lexer->lookahead == '&') {
             lexer->result_symbol = EMPTY_VALUE;
             return true;
         }
     }
 
-    if ((valid_symbols[HEREDOC_BODY_BEGINNING] || valid_symbols[SIMPLE_HEREDOC_BODY]) && scanner->heredocs.size > 0 &&
-        !array_back(&scanner->heredocs)->started && !in_error_recovery(valid_symbols)) {
+    if (!(valid & HEREDOC_TOKENS)) {
+        goto word;
+    }
+
+heredoc:
+    if ((is_valid(valid, HEREDOC_BODY_BEGINNING) || is_valid(valid, SIMPLE_HEREDOC_BODY)) &&
+        scanner->heredocs.size > 0 && !array_back(&scanner->heredocs)->started && !in_error_recovery(valid)) {
+        scanner->heredoc_state_is_current = false;
         return scan_heredoc_content(scanner, lexer, HEREDOC_BODY_BEGINNING, SIMPLE_HEREDOC_BODY);
     }
 
-    if (valid_symbols[HEREDOC_END] && scanner->heredocs.size > 0) {
+    if (is_valid(valid, HEREDOC_END) && scanner->heredocs.size > 0) {
         Heredoc *heredoc = array_back(&scanner->heredocs);
         if (scan_heredoc_end_identifier(heredoc, lexer)) {
-            array_delete(&heredoc->current_leading_word);
-            array_delete(&heredoc->delimiter);
+            scanner->heredoc_state_is_current = false;
+            delimiter_delete(&heredoc->delimiter);
             array_pop(&scanner->heredocs);
             lexer->result_symbol = HEREDOC_END;
             return true;
         }
     }
 
-    if (valid_symbols[HEREDOC_CONTENT] && scanner->heredocs.size > 0 && array_back(&scanner->heredocs)->started &&
-        !in_error_recovery(valid_symbols)) {
-        return scan_heredoc_content(scanner, lexer, HEREDOC_CONTENT, HEREDOC_END);
+    if (is_valid(valid, HEREDOC_CONTENT) && scanner->heredocs.size > 0 && array_back(&scanner->heredocs)->started &&
+        !in_error_recovery(valid)) {
+        scanner->heredoc_state_is_current = false;
+        // The rest of a raw body can't contain expansions, and the text before
+        // the first expansion of any other body belongs to its beginning, so
+        // both get hidden tokens, and the body shows up as a single node
+        // however many chunks it takes.
+        Heredoc *heredoc = array_back(&scanner->heredocs);
+        enum TokenType middle_type = heredoc->is_raw || !heredoc->is_expanded ? RAW_HEREDOC_CONTENT : HEREDOC_CONTENT;
+        return scan_heredoc_content(scanner, lexer, middle_type, HEREDOC_END);
     }
 
-    if (valid_symbols[HEREDOC_START] && !in_error_recovery(valid_symbols) && scanner->heredocs.size > 0) {
+    if (is_valid(valid, HEREDOC_START) && !in_error_recovery(valid) && scanner->heredocs.size > 0) {
+        scanner->heredoc_state_is_current = false;
         return scan_heredoc_start(array_back(&scanner->heredocs), lexer);
     }
 
-    if (valid_symbols[TEST_OPERATOR] && !valid_symbols[EXPANSION_WORD]) {
-        while (iswspace(lexer->lookahead) && lexer->lookahead != '\n') {
+word:
+    if (!(valid & WORD_TOKENS)) {
+        return false;
+    }
+
+    if (is_valid(valid, TEST_OPERATOR) && !is_valid(valid, EXPANSION_WORD)) {
+        while (is_space(lexer->lookahead) && lexer->lookahead != '\n') {
             skip(lexer);
         }
 
         if (lexer->lookahead == '\\') {
-            if (valid_symbols[EXTGLOB_PATTERN]) {
+            if (is_valid(valid, EXTGLOB_PATTERN)) {
                 goto extglob_pattern;
             }
-            if (valid_symbols[REGEX_NO_SPACE]) {
+            if (is_valid(valid, REGEX_NO_SPACE)) {
                 goto regex;
             }
             skip(lexer);
@@ -489,15 +1206,15 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
                 return false;
             }
 
-            while (iswspace(lexer->lookahead)) {
+            while (is_space(lexer->lookahead)) {
                 skip(lexer);
             }
         }
 
-        if (lexer->lookahead == '\n' && !valid_symbols[NEWLINE]) {
+        if (lexer->lookahead == '\n' && !is_valid(valid, NEWLINE)) {
             skip(lexer);
 
-            while (iswspace(lexer->lookahead)) {
+            while (is_space(lexer->lookahead)) {
                 skip(lexer);
             }
         }
@@ -506,42 +1223,41 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
             advance(lexer);
 
             bool advanced_once = false;
-            while (iswalpha(lexer->lookahead)) {
+            while (is_alpha(lexer->lookahead)) {
                 advanced_once = true;
                 advance(lexer);
             }
 
-            if (iswspace(lexer->lookahead) && advanced_once) {
+            if (is_space(lexer->lookahead) && advanced_once) {
                 lexer->mark_end(lexer);
-                advance(lexer);
-                if (lexer->lookahead == '}' && valid_symbols[CLOSING_BRACE]) {
-                    if (valid_symbols[EXPANSION_WORD]) {
-                        lexer->mark_end(lexer);
-                        lexer->result_symbol = EXPANSION_WORD;
-                        return true;
-                    }
-                    return false;
-                }
                 lexer->result_symbol = TEST_OPERATOR;
-                return true;
+                // Unless a `}` after it could close a brace group, the
+                // operator is decided without looking past the space.
+                if (!is_valid(valid, CLOSING_BRACE)) {
+                    return true;
+                }
+                advance(lexer);
+                return lexer->lookahead != '}';
             }
-            if (iswspace(lexer->lookahead) && valid_symbols[EXTGLOB_PATTERN]) {
+            if (is_space(lexer->lookahead) && is_valid(valid, EXTGLOB_PATTERN)) {
                 lexer->result_symbol = EXTGLOB_PATTERN;
                 return true;
             }
         }
 
-        if (valid_symbols[BARE_DOLLAR] && !in_error_recovery(valid_symbols) && scan_bare_dollar(lexer)) {
-            return true;
+        // Nothing else here starts with a `$`, so once one has been
+        // consumed the character after it decides.
+        if (lexer->lookahead == '$' && is_valid(valid, BARE_DOLLAR) && !in_error_recovery(valid)) {
+            return scan_bare_dollar(lexer);
         }
     }
 
-    if ((valid_symbols[VARIABLE_NAME] || valid_symbols[FILE_DESCRIPTOR] || valid_symbols[HEREDOC_ARROW]) &&
-        !valid_symbols[REGEX_NO_SLASH] && !in_error_recovery(valid_symbols)) {
+    if ((is_valid(valid, VARIABLE_NAME) || is_valid(valid, FILE_DESCRIPTOR) || is_valid(valid, HEREDOC_ARROW)) &&
+        !is_valid(valid, REGEX_NO_SLASH) && !in_error_recovery(valid)) {
         for (;;) {
             if ((lexer->lookahead == ' ' || lexer->lookahead == '\t' || lexer->lookahead == '\r' ||
-                 (lexer->lookahead == '\n' && !valid_symbols[NEWLINE])) &&
-                !valid_symbols[EXPANSION_WORD]) {
+                 (lexer->lookahead == '\n' && !is_valid(valid, NEWLINE))) &&
+                !is_valid(valid, EXPANSION_WORD)) {
                 skip(lexer);
             } else if (lexer->lookahead == '\\') {
                 skip(lexer);
@@ -558,7 +1274,7 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
                 if (lexer->lookahead == '\n') {
                     skip(lexer);
                 } else {
-                    if (lexer->lookahead == '\\' && valid_symbols[EXPANSION_WORD]) {
+                    if (lexer->lookahead == '\\' && is_valid(valid, EXPANSION_WORD)) {
                         goto expansion_word;
                     }
                     return false;
@@ -568,8 +1284,15 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
             }
         }
 
+        // Data appended to a self-extracting script, right after the script
+        // ends.
+        if (is_valid(valid, PAYLOAD_START) && is_binary(lexer)) {
+            return scan_payload(lexer, PAYLOAD_START);
+        }
+
         // no '*', '@', '?', '-', '$', '0', '_'
-        if (!valid_symbols[EXPANSION_WORD] &&
+        bool after_underscore = lexer->lookahead == '_';
+        if (!is_valid(valid, EXPANSION_WORD) &&
             (lexer->lookahead == '*' || lexer->lookahead == '@' || lexer->lookahead == '?' || lexer->lookahead == '-' ||
              lexer->lookahead == '0' || lexer->lookahead == '_')) {
             lexer->mark_end(lexer);
@@ -579,14 +1302,14 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
                 lexer->lookahead == '/') {
                 return false;
             }
-            if (valid_symbols[EXTGLOB_PATTERN] && iswspace(lexer->lookahead)) {
+            if (is_valid(valid, EXTGLOB_PATTERN) && is_space(lexer->lookahead)) {
                 lexer->mark_end(lexer);
                 lexer->result_symbol = EXTGLOB_PATTERN;
                 return true;
             }
         }
 
-        if (valid_symbols[HEREDOC_ARROW] && lexer->lookahead == '<') {
+        if (is_valid(valid, HEREDOC_ARROW) && lexer->lookahead == '<') {
             advance(lexer);
             if (lexer->lookahead == '<') {
                 advance(lexer);
@@ -595,12 +1318,14 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
                     Heredoc heredoc = heredoc_new();
                     heredoc.allows_indent = true;
                     array_push(&scanner->heredocs, heredoc);
+                    scanner->heredoc_state_is_current = false;
                     lexer->result_symbol = HEREDOC_ARROW_DASH;
                 } else if (lexer->lookahead == '<' || lexer->lookahead == '=') {
                     return false;
                 } else {
                     Heredoc heredoc = heredoc_new();
                     array_push(&scanner->heredocs, heredoc);
+                    scanner->heredoc_state_is_current = false;
                     lexer->result_symbol = HEREDOC_ARROW;
                 }
                 return true;
@@ -609,28 +1334,34 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
         }
 
         bool is_number = true;
-        if (iswdigit(lexer->lookahead)) {
+        if (is_digit(lexer->lookahead)) {
             advance(lexer);
-        } else if (iswalpha(lexer->lookahead) || lexer->lookahead == '_') {
+        } else if (is_alpha(lexer->lookahead) || lexer->lookahead == '_') {
             is_number = false;
-            advance(lexer);
+            if (is_valid(valid, PAYLOAD_START) && after_underscore && !is_valid(valid, EXPANSION_WORD)) {
+                if (scan_payload_marker(lexer)) {
+                    return true;
+                }
+            } else {
+                advance(lexer);
+            }
         } else {
             if (lexer->lookahead == '{') {
                 goto brace_start;
             }
-            if (valid_symbols[EXPANSION_WORD]) {
+            if (is_valid(valid, EXPANSION_WORD)) {
                 goto expansion_word;
             }
-            if (valid_symbols[EXTGLOB_PATTERN]) {
+            if (is_valid(valid, EXTGLOB_PATTERN)) {
                 goto extglob_pattern;
             }
             return false;
         }
 
         for (;;) {
-            if (iswdigit(lexer->lookahead)) {
+            if (is_digit(lexer->lookahead)) {
                 advance(lexer);
-            } else if (iswalpha(lexer->lookahead) || lexer->lookahead == '_') {
+            } else if (is_alpha(lexer->lookahead) || lexer->lookahead == '_') {
                 is_number = false;
                 advance(lexer);
             } else {
@@ -638,16 +1369,16 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
             }
         }
 
-        if (is_number && valid_symbols[FILE_DESCRIPTOR] && (lexer->lookahead == '>' || lexer->lookahead == '<')) {
+        if (is_number && is_valid(valid, FILE_DESCRIPTOR) && (lexer->lookahead == '>' || lexer->lookahead == '<')) {
             lexer->result_symbol = FILE_DESCRIPTOR;
             return true;
         }
 
-        if (valid_symbols[VARIABLE_NAME]) {
+        if (is_valid(valid, VARIABLE_NAME)) {
             if (lexer->lookahead == '+') {
                 lexer->mark_end(lexer);
                 advance(lexer);
-                if (lexer->lookahead == '=' || lexer->lookahead == ':' || valid_symbols[CLOSING_BRACE]) {
+                if (lexer->lookahead == '=' || lexer->lookahead == ':' || is_valid(valid, CLOSING_BRACE)) {
                     lexer->result_symbol = VARIABLE_NAME;
                     return true;
                 }
@@ -657,12 +1388,12 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
                 return false;
             }
             if (lexer->lookahead == '=' || lexer->lookahead == '[' ||
-                (lexer->lookahead == ':' && !valid_symbols[CLOSING_BRACE] &&
-                 !valid_symbols[OPENING_PAREN]) || // TODO(amaanq): more cases for regular word chars but not variable
+                (lexer->lookahead == ':' && !is_valid(valid, CLOSING_BRACE) &&
+                 !is_valid(valid, OPENING_PAREN)) || // TODO(amaanq): more cases for regular word chars but not variable
                                                    // names for function words, only handling : for now? #235
                 lexer->lookahead == '%' ||
                 (lexer->lookahead == '#' && !is_number) || lexer->lookahead == '@' ||
-                (lexer->lookahead == '-' && valid_symbols[CLOSING_BRACE])) {
+                (lexer->lookahead == '-' && is_valid(valid, CLOSING_BRACE))) {
                 lexer->mark_end(lexer);
                 lexer->result_symbol = VARIABLE_NAME;
                 return true;
@@ -672,29 +1403,29 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
                 lexer->mark_end(lexer);
                 advance(lexer);
                 lexer->result_symbol = VARIABLE_NAME;
-                return iswalpha(lexer->lookahead);
+                return is_alpha(lexer->lookahead);
             }
         }
 
         return false;
     }
 
-    if (valid_symbols[BARE_DOLLAR] && !in_error_recovery(valid_symbols) && scan_bare_dollar(lexer)) {
+    if (is_valid(valid, BARE_DOLLAR) && !in_error_recovery(valid) && scan_bare_dollar(lexer)) {
         return true;
     }
 
 regex:
-    if ((valid_symbols[REGEX] || valid_symbols[REGEX_NO_SLASH] || valid_symbols[REGEX_NO_SPACE]) &&
-        !in_error_recovery(valid_symbols)) {
-        if (valid_symbols[REGEX] || valid_symbols[REGEX_NO_SPACE]) {
-            while (iswspace(lexer->lookahead)) {
+    if ((is_valid(valid, REGEX) || is_valid(valid, REGEX_NO_SLASH) || is_valid(valid, REGEX_NO_SPACE)) &&
+        !in_error_recovery(valid)) {
+        if (is_valid(valid, REGEX) || is_valid(valid, REGEX_NO_SPACE)) {
+            while (is_space(lexer->lookahead)) {
                 skip(lexer);
             }
         }
 
         if ((lexer->lookahead != '"' && lexer->lookahead != '\'') ||
-            ((lexer->lookahead == '$' || lexer->lookahead == '\'') && valid_symbols[REGEX_NO_SLASH]) ||
-            (lexer->lookahead == '\'' && valid_symbols[REGEX_NO_SPACE])) {
+            ((lexer->lookahead == '$' || lexer->lookahead == '\'') && is_valid(valid, REGEX_NO_SLASH)) ||
+            (lexer->lookahead == '\'' && is_valid(valid, REGEX_NO_SPACE))) {
             typedef struct {
                 bool done;
                 bool advanced_once;
@@ -706,7 +1437,7 @@ regex:
                 uint32_t brace_depth;
             } State;
 
-            if (lexer->lookahead == '$' && valid_symbols[REGEX_NO_SLASH]) {
+            if (lexer->lookahead == '$' && is_valid(valid, REGEX_NO_SLASH)) {
                 lexer->mark_end(lexer);
                 advance(lexer);
                 if (lexer->lookahead == '(') {
@@ -717,7 +1448,11 @@ regex:
             lexer->mark_end(lexer);
 
             State state = {false, false, false, false, false, 0, 0, 0};
+            uint32_t lookahead = 0;
             while (!state.done) {
+                if (++lookahead > TREE_SITTER_BASH_LOOKAHEAD_LIMIT) {
+                    return false;
+                }
                 if (state.in_single_quote) {
                     if (lexer->lookahead == '\'') {
                         state.in_single_quote = false;
@@ -731,6 +1466,17 @@ regex:
                         break;
                     case '\0':
                         return false;
+                    case '\n':
+                        // Within `[[ ]]`, an unquoted newline ends the regex.
+                        // It can't close a group that is still open.
+                        if (is_valid(valid, REGEX) && !state.in_single_quote && !state.last_was_escape) {
+                            if (state.paren_depth > 0 || state.bracket_depth > 0 || state.brace_depth > 0) {
+                                return false;
+                            }
+                            state.done = true;
+                        }
+                        state.last_was_escape = false;
+                        break;
                     case '(':
                         state.paren_depth++;
                         state.last_was_escape = false;
@@ -779,14 +1525,14 @@ regex:
                 }
 
                 if (!state.done) {
-                    if (valid_symbols[REGEX]) {
-                        bool was_space = !state.in_single_quote && iswspace(lexer->lookahead);
+                    if (is_valid(valid, REGEX)) {
+                        bool was_space = !state.in_single_quote && is_space(lexer->lookahead);
                         advance(lexer);
                         state.advanced_once = true;
                         if (!was_space || state.paren_depth > 0) {
                             lexer->mark_end(lexer);
                         }
-                    } else if (valid_symbols[REGEX_NO_SLASH]) {
+                    } else if (is_valid(valid, REGEX_NO_SLASH)) {
                         if (lexer->lookahead == '/') {
                             lexer->mark_end(lexer);
                             lexer->result_symbol = REGEX_NO_SLASH;
@@ -800,14 +1546,14 @@ regex:
                                 lexer->mark_end(lexer);
                             }
                         } else {
-                            bool was_space = !state.in_single_quote && iswspace(lexer->lookahead);
+                            bool was_space = !state.in_single_quote && is_space(lexer->lookahead);
                             advance(lexer);
                             state.advanced_once = true;
                             if (!was_space) {
                                 lexer->mark_end(lexer);
                             }
                         }
-                    } else if (valid_symbols[REGEX_NO_SPACE]) {
+                    } else if (is_valid(valid, REGEX_NO_SPACE)) {
                         if (lexer->lookahead == '\\') {
                             state.found_non_alnumdollarunderdash = true;
                             advance(lexer);
@@ -824,19 +1570,19 @@ regex:
                             }
                             // end $ always means regex, e.g.
                             // 99999999$
-                            if (iswspace(lexer->lookahead)) {
+                            if (is_space(lexer->lookahead)) {
                                 lexer->result_symbol = REGEX_NO_SPACE;
                                 lexer->mark_end(lexer);
                                 return true;
                             }
                         } else {
-                            bool was_space = !state.in_single_quote && iswspace(lexer->lookahead);
+                            bool was_space = !state.in_single_quote && is_space(lexer->lookahead);
                             if (was_space && state.paren_depth == 0) {
                                 lexer->mark_end(lexer);
                                 lexer->result_symbol = REGEX_NO_SPACE;
                                 return state.found_non_alnumdollarunderdash;
                             }
-                            if (!iswalnum(lexer->lookahead) && lexer->lookahead != '$' && lexer->lookahead != '-' &&
+                            if (!is_alnum(lexer->lookahead) && lexer->lookahead != '$' && lexer->lookahead != '-' &&
                                 lexer->lookahead != '_') {
                                 state.found_non_alnumdollarunderdash = true;
                             }
@@ -846,10 +1592,10 @@ regex:
                 }
             }
 
-            lexer->result_symbol = valid_symbols[REGEX_NO_SLASH]   ? REGEX_NO_SLASH
-                                   : valid_symbols[REGEX_NO_SPACE] ? REGEX_NO_SPACE
+            lexer->result_symbol = is_valid(valid, REGEX_NO_SLASH)   ? REGEX_NO_SLASH
+                                   : is_valid(valid, REGEX_NO_SPACE) ? REGEX_NO_SPACE
                                                                    : REGEX;
-            if (valid_symbols[REGEX] && !state.advanced_once) {
+            if (is_valid(valid, REGEX) && !state.advanced_once) {
                 return false;
             }
             return true;
@@ -857,18 +1603,18 @@ regex:
     }
 
 extglob_pattern:
-    if (valid_symbols[EXTGLOB_PATTERN] && !in_error_recovery(valid_symbols)) {
+    if (is_valid(valid, EXTGLOB_PATTERN) && !in_error_recovery(valid)) {
         // first skip ws, then check for ? * + @ !
-        while (iswspace(lexer->lookahead)) {
+        while (is_space(lexer->lookahead)) {
             skip(lexer);
         }
 
         if (lexer->lookahead == '?' || lexer->lookahead == '*' || lexer->lookahead == '+' || lexer->lookahead == '@' ||
             lexer->lookahead == '!' || lexer->lookahead == '-' || lexer->lookahead == ')' || lexer->lookahead == '\\' ||
-            lexer->lookahead == '.' || lexer->lookahead == '[' || (iswalpha(lexer->lookahead))) {
+            lexer->lookahead == '.' || lexer->lookahead == '[' || (is_alpha(lexer->lookahead))) {
             if (lexer->lookahead == '\\') {
                 advance(lexer);
-                if ((iswspace(lexer->lookahead) || lexer->lookahead == '"') && lexer->lookahead != '\r' &&
+                if ((is_space(lexer->lookahead) || lexer->lookahead == '"') && lexer->lookahead != '\r' &&
                     lexer->lookahead != '\n') {
                     advance(lexer);
                 } else {
@@ -880,17 +1626,16 @@ extglob_pattern:
                 lexer->mark_end(lexer);
                 advance(lexer);
 
-                if (iswspace(lexer->lookahead)) {
+                if (is_space(lexer->lookahead)) {
                     return false;
                 }
             }
 
             lexer->mark_end(lexer);
-            bool was_non_alpha = !iswalpha(lexer->lookahead);
+            bool was_non_alpha = !is_alpha(lexer->lookahead);
             if (lexer->lookahead != '[') {
                 // no esac
                 if (lexer->lookahead == 'e') {
-                    lexer->mark_end(lexer);
                     advance(lexer);
                     if (lexer->lookahead == 's') {
                         advance(lexer);
@@ -898,7 +1643,7 @@ extglob_pattern:
                             advance(lexer);
                             if (lexer->lookahead == 'c') {
                                 advance(lexer);
-                                if (iswspace(lexer->lookahead)) {
+                                if (is_space(lexer->lookahead)) {
                                     return false;
                                 }
                             }
@@ -913,7 +1658,7 @@ extglob_pattern:
             if (lexer->lookahead == '-') {
                 lexer->mark_end(lexer);
                 advance(lexer);
-                while (iswalnum(lexer->lookahead)) {
+                while (is_alnum(lexer->lookahead)) {
                     advance(lexer);
                 }
 
@@ -927,13 +1672,13 @@ extglob_pattern:
             if (lexer->lookahead == ')' && scanner->last_glob_paren_depth == 0) {
                 lexer->mark_end(lexer);
                 advance(lexer);
-                if (iswspace(lexer->lookahead)) {
+                if (is_space(lexer->lookahead)) {
                     lexer->result_symbol = EXTGLOB_PATTERN;
                     return was_non_alpha;
                 }
             }
 
-            if (iswspace(lexer->lookahead)) {
+            if (is_space(lexer->lookahead)) {
                 lexer->mark_end(lexer);
                 lexer->result_symbol = EXTGLOB_PATTERN;
                 scanner->last_glob_paren_depth = 0;
@@ -956,7 +1701,7 @@ extglob_pattern:
                 return true;
             }
 
-            if (!iswalnum(lexer->lookahead) && lexer->lookahead != '(' && lexer->lookahead != '"' &&
+            if (!is_alnum(lexer->lookahead) && lexer->lookahead != '(' && lexer->lookahead != '"' &&
                 lexer->lookahead != '[' && lexer->lookahead != '?' && lexer->lookahead != '/' &&
                 lexer->lookahead != '\\' && lexer->lookahead != '_' && lexer->lookahead != '*') {
                 return false;
@@ -971,7 +1716,11 @@ extglob_pattern:
             } State;
 
             State state = {false, was_non_alpha, scanner->last_glob_paren_depth, 0, 0};
+            uint32_t lookahead = 0;
             while (!state.done) {
+                if (++lookahead > TREE_SITTER_BASH_LOOKAHEAD_LIMIT) {
+                    return false;
+                }
                 switch (lexer->lookahead) {
                     case '\0':
                         return false;
@@ -1014,10 +1763,10 @@ extglob_pattern:
                 }
 
                 if (!state.done) {
-                    bool was_space = iswspace(lexer->lookahead);
+                    bool was_space = is_space(lexer->lookahead);
                     if (lexer->lookahead == '$') {
                         lexer->mark_end(lexer);
-                        if (!iswalpha(lexer->lookahead) && lexer->lookahead != '.' && lexer->lookahead != '\\') {
+                        if (!is_alpha(lexer->lookahead) && lexer->lookahead != '.' && lexer->lookahead != '\\') {
                             state.saw_non_alphadot = true;
                         }
                         advance(lexer);
@@ -1040,15 +1789,15 @@ extglob_pattern:
                         return state.saw_non_alphadot;
                     }
                     if (lexer->lookahead == '\\') {
-                        if (!iswalpha(lexer->lookahead) && lexer->lookahead != '.' && lexer->lookahead != '\\') {
+                        if (!is_alpha(lexer->lookahead) && lexer->lookahead != '.' && lexer->lookahead != '\\') {
                             state.saw_non_alphadot = true;
                         }
                         advance(lexer);
-                        if (iswspace(lexer->lookahead) || lexer->lookahead == '"') {
+                        if (is_space(lexer->lookahead) || lexer->lookahead == '"') {
                             advance(lexer);
                         }
                     } else {
-                        if (!iswalpha(lexer->lookahead) && lexer->lookahead != '.' && lexer->lookahead != '\\') {
+                        if (!is_alpha(lexer->lookahead) && lexer->lookahead != '.' && lexer->lookahead != '\\') {
                             state.saw_non_alphadot = true;
                         }
                         advance(lexer);
@@ -1069,10 +1818,14 @@ extglob_pattern:
     }
 
 expansion_word:
-    if (valid_symbols[EXPANSION_WORD]) {
+    if (is_valid(valid, EXPANSION_WORD)) {
         bool advanced_once = false;
         bool advance_once_space = false;
+        uint32_t lookahead = 0;
         for (;;) {
+            if (++lookahead > TREE_SITTER_BASH_LOOKAHEAD_LIMIT) {
+                return false;
+            }
             if (lexer->lookahead == '\"') {
                 return false;
             }
@@ -1080,7 +1833,7 @@ expansion_word:
                 lexer->mark_end(lexer);
                 advance(lexer);
                 if (lexer->lookahead == '{' || lexer->lookahead == '(' || lexer->lookahead == '\'' ||
-                    iswalnum(lexer->lookahead)) {
+                    is_alnum(lexer->lookahead)) {
                     lexer->result_symbol = EXPANSION_WORD;
                     return advanced_once;
                 }
@@ -1097,6 +1850,9 @@ expansion_word:
                 lexer->mark_end(lexer);
                 advance(lexer);
                 while (lexer->lookahead != ')' && !lexer->eof(lexer)) {
+                    if (++lookahead > TREE_SITTER_BASH_LOOKAHEAD_LIMIT) {
+                        return false;
+                    }
                     // if we find a $( or ${ assume this is valid and is
                     // a garbage concatenation of some weird word + an
                     // expansion
@@ -1105,14 +1861,14 @@ expansion_word:
                         lexer->mark_end(lexer);
                         advance(lexer);
                         if (lexer->lookahead == '{' || lexer->lookahead == '(' || lexer->lookahead == '\'' ||
-                            iswalnum(lexer->lookahead)) {
+                            is_alnum(lexer->lookahead)) {
                             lexer->result_symbol = EXPANSION_WORD;
                             return advanced_once;
                         }
                         advanced_once = true;
                     } else {
-                        advanced_once = advanced_once || !iswspace(lexer->lookahead);
-                        advance_once_space = advance_once_space || iswspace(lexer->lookahead);
+                        advanced_once = advanced_once || !is_space(lexer->lookahead);
+                        advance_once_space = advance_once_space || is_space(lexer->lookahead);
                         advance(lexer);
                     }
                 }
@@ -1136,15 +1892,15 @@ expansion_word:
             if (lexer->eof(lexer)) {
                 return false;
             }
-            advanced_once = advanced_once || !iswspace(lexer->lookahead);
-            advance_once_space = advance_once_space || iswspace(lexer->lookahead);
+            advanced_once = advanced_once || !is_space(lexer->lookahead);
+            advance_once_space = advance_once_space || is_space(lexer->lookahead);
             advance(lexer);
         }
     }
 
 brace_start:
-    if (valid_symbols[BRACE_START] && !in_error_recovery(valid_symbols)) {
-        while (iswspace(lexer->lookahead)) {
+    if (is_valid(valid, BRACE_START) && !in_error_recovery(valid)) {
+        while (is_space(lexer->lookahead)) {
             skip(lexer);
         }
 
@@ -1155,7 +1911,7 @@ brace_start:
         advance(lexer);
         lexer->mark_end(lexer);
 
-        while (isdigit(lexer->lookahead)) {
+        while (is_digit(lexer->lookahead)) {
             advance(lexer);
         }
 
@@ -1169,7 +1925,7 @@ brace_start:
         }
         advance(lexer);
 
-        while (isdigit(lexer->lookahead)) {
+        while (is_digit(lexer->lookahead)) {
             advance(lexer);
         }
 
@@ -1184,6 +1940,164 @@ brace_start:
     return false;
 }
 
+#ifdef TREE_SITTER_BASH_STATS
+
+// The size of the external scanner state that the runtime stores inline.
+#define TREE_SITTER_BASH_INLINE_STATE_SIZE 24
+
+static const char *const TOKEN_NAMES[] = {
+    [HEREDOC_START] = "heredoc_start",
+    [SIMPLE_HEREDOC_BODY] = "simple_heredoc_body",
+    [HEREDOC_BODY_BEGINNING] = "heredoc_body_beginning",
+    [HEREDOC_CONTENT] = "heredoc_content",
+    [HEREDOC_END] = "heredoc_end",
+    [FILE_DESCRIPTOR] = "file_descriptor",
+    [EMPTY_VALUE] = "empty_value",
+    [CONCAT] = "concat",
+    [VARIABLE_NAME] = "variable_name",
+    [TEST_OPERATOR] = "test_operator",
+    [REGEX] = "regex",
+    [REGEX_NO_SLASH] = "regex_no_slash",
+    [REGEX_NO_SPACE] = "regex_no_space",
+    [EXPANSION_WORD] = "expansion_word",
+    [EXTGLOB_PATTERN] = "extglob_pattern",
+    [BARE_DOLLAR] = "bare_dollar",
+    [BRACE_START] = "brace_start",
+    [IMMEDIATE_DOUBLE_HASH] = "immediate_double_hash",
+    [EXTERNAL_EXPANSION_SYM_HASH] = "external_expansion_sym_hash",
+    [EXTERNAL_EXPANSION_SYM_BANG] = "external_expansion_sym_bang",
+    [EXTERNAL_EXPANSION_SYM_EQUAL] = "external_expansion_sym_equal",
+    [CLOSING_BRACE] = "closing_brace",
+    [CLOSING_BRACKET] = "closing_bracket",
+    [HEREDOC_ARROW] = "heredoc_arrow",
+    [HEREDOC_ARROW_DASH] = "heredoc_arrow_dash",
+    [NEWLINE] = "newline",
+    [OPENING_PAREN] = "opening_paren",
+    [RAW_HEREDOC_CONTENT] = "raw_heredoc_content",
+    [PAYLOAD_START] = "payload_start",
+    [PAYLOAD_CONTENT] = "payload_content",
+    [SCRIPT_START] = "script_start",
+    // Calls that return without ever choosing a token to produce.
+    [ERROR_RECOVERY] = "none",
+};
+
+_Static_assert(sizeof(TOKEN_NAMES) / sizeof(TOKEN_NAMES[0]) == TREE_SITTER_BASH_EXTERNAL_TOKEN_COUNT,
+               "TREE_SITTER_BASH_EXTERNAL_TOKEN_COUNT is out of sync with TokenType");
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+// The counters that scanners running on this thread add to, owned by the
+// caller of tree_sitter_bash_external_scanner_collect_stats.
+static THREAD_LOCAL TSBashScannerStats *collected_stats = NULL;
+
+/**
+ * Forwards every call to the runtime's lexer, counting the characters that
+ * are consumed and where the token was last marked to end.
+ */
+typedef struct {
+    TSLexer lexer;
+    TSLexer *inner;
+    uint64_t consumed;
+    uint64_t consumed_at_mark_end;
+    uint64_t get_column_calls;
+    bool did_mark_end;
+} StatsLexer;
+
+static void stats_advance(TSLexer *lexer, bool skip) {
+    StatsLexer *self = (StatsLexer *)lexer;
+    if (!self->inner->eof(self->inner)) {
+        self->consumed++;
+    }
+    self->inner->advance(self->inner, skip);
+    self->lexer.lookahead = self->inner->lookahead;
+}
+
+static void stats_mark_end(TSLexer *lexer) {
+    StatsLexer *self = (StatsLexer *)lexer;
+    self->consumed_at_mark_end = self->consumed;
+    self->did_mark_end = true;
+    self->inner->mark_end(self->inner);
+}
+
+static uint32_t stats_get_column(TSLexer *lexer) {
+    StatsLexer *self = (StatsLexer *)lexer;
+    self->get_column_calls++;
+    return self->inner->get_column(self->inner);
+}
+
+static bool stats_is_at_included_range_start(const TSLexer *lexer) {
+    const StatsLexer *self = (const StatsLexer *)lexer;
+    return self->inner->is_at_included_range_start(self->inner);
+}
+
+static bool stats_eof(const TSLexer *lexer) {
+    const StatsLexer *self = (const StatsLexer *)lexer;
+    return self->inner->eof(self->inner);
+}
+
+static void stats_log(const TSLexer *lexer, const char *format, ...) {
+    const StatsLexer *self = (const StatsLexer *)lexer;
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    self->inner->log(self->inner, "%s", message);
+}
+
+static bool scan_with_stats(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
+    if (!collected_stats) {
+        return scan(scanner, lexer, valid_symbols);
+    }
+
+    StatsLexer stats_lexer = {
+        .lexer =
+            {
+                .lookahead = lexer->lookahead,
+                .result_symbol = ERROR_RECOVERY,
+                .advance = stats_advance,
+                .mark_end = stats_mark_end,
+                .get_column = stats_get_column,
+                .is_at_included_range_start = stats_is_at_included_range_start,
+                .eof = stats_eof,
+                .log = stats_log,
+            },
+        .inner = lexer,
+    };
+
+    bool result = scan(scanner, &stats_lexer.lexer, valid_symbols);
+    lexer->result_symbol = stats_lexer.lexer.result_symbol;
+
+    // The result symbol is only meaningful on success, but the scanner sets
+    // it as soon as it commits to a token, so it also says which path a
+    // failed call spent its time in.
+    TSBashScannerTokenStats *stats = &collected_stats->tokens[stats_lexer.lexer.result_symbol];
+    stats->calls++;
+    stats->consumed += stats_lexer.consumed;
+    stats->get_column_calls += stats_lexer.get_column_calls;
+    if (result) {
+        stats->returns++;
+        if (stats_lexer.did_mark_end) {
+            stats->lookahead += stats_lexer.consumed - stats_lexer.consumed_at_mark_end;
+        }
+    } else {
+        stats->lookahead += stats_lexer.consumed;
+    }
+    return result;
+}
+
+void tree_sitter_bash_external_scanner_collect_stats(TSBashScannerStats *stats) { collected_stats = stats; }
+
+const char *tree_sitter_bash_external_scanner_token_name(unsigned token) {
+    return token < TREE_SITTER_BASH_EXTERNAL_TOKEN_COUNT ? TOKEN_NAMES[token] : NULL;
+}
+
+#endif
+
 void *tree_sitter_bash_external_scanner_create() {
     Scanner *scanner = calloc(1, sizeof(Scanner));
     array_init(&scanner->heredocs);
@@ -1192,12 +2106,26 @@ void *tree_sitter_bash_external_scanner_create() {
 
 bool tree_sitter_bash_external_scanner_scan(void *payload, TSLexer *lexer, const bool *valid_symbols) {
     Scanner *scanner = (Scanner *)payload;
+#ifdef TREE_SITTER_BASH_STATS
+    return scan_with_stats(scanner, lexer, valid_symbols);
+#else
     return scan(scanner, lexer, valid_symbols);
+#endif
 }
 
 unsigned tree_sitter_bash_external_scanner_serialize(void *payload, char *state) {
     Scanner *scanner = (Scanner *)payload;
-    return serialize(scanner, state);
+    unsigned length = serialize(scanner, state);
+#ifdef TREE_SITTER_BASH_STATS
+    if (collected_stats) {
+        collected_stats->serializations++;
+        collected_stats->serialized_bytes += length;
+        if (length > TREE_SITTER_BASH_INLINE_STATE_SIZE) {
+            collected_stats->serialized_large++;
+        }
+    }
+#endif
+    return length;
 }
 
 void tree_sitter_bash_external_scanner_deserialize(void *payload, const char *state, unsigned length) {
@@ -1209,8 +2137,7 @@ void tree_sitter_bash_external_scanner_destroy(void *payload) {
     Scanner *scanner = (Scanner *)payload;
     for (size_t i = 0; i < scanner->heredocs.size; i++) {
         Heredoc *heredoc = array_get(&scanner->heredocs, i);
-        array_delete(&heredoc->current_leading_word);
-        array_delete(&heredoc->delimiter);
+        delimiter_delete(&heredoc->delimiter);
     }
     array_delete(&scanner->heredocs);
     free(scanner);
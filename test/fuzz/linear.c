@@ -0,0 +1,225 @@
+/**
+ * Fuzz target for inputs that take super-linear time to parse.
+ *
+ * Every input is parsed with a scanner built with TREE_SITTER_BASH_STATS, and
+ * so is the input repeated twice. The check counts the characters the
+ * external scanner advanced over, which must stay within a fixed multiple of
+ * the input length, plus some slack for short inputs. An input over that limit
+ * aborts, so that libFuzzer records it as a crash and can minimize it like
+ * one. The times of the two parses are reported next to the count, since
+ * twice the input taking four times as long points at a quadratic parse, but
+ * they never decide the outcome: they vary too much from run to run.
+ *
+ *     make fuzz-linear
+ *     test/fuzz/linear-fuzzer -minimize_crash=1 -runs=100000 \
+ *         -exact_artifact_path=test/fuzz/regressions/<name>.sh test/fuzz/artifacts/crash-...
+ *
+ * Built without libFuzzer, this file is the regression suite instead. It
+ * replays every file under the given paths (default: `test/lookahead`, the
+ * inputs that made the scanner look ahead to the end of the file, and
+ * `test/fuzz/regressions`, the minimized fuzzer findings, if it exists), prints the results as a JSON object on stdout, and exits non-zero if any
+ * input is over a limit.
+ *
+ *     test/fuzz/linear [-r repeat] [path...]
+ */
+
+#define _XOPEN_SOURCE 700
+#define BENCH_NAME "linear"
+
+#include "../../bench/common.h"
+#include "tree_sitter/api.h"
+#include "tree_sitter/tree-sitter-bash.h"
+
+#include <unistd.h>
+
+#ifndef TREE_SITTER_BASH_STATS
+#error "test/fuzz/linear.c needs a scanner built with TREE_SITTER_BASH_STATS"
+#endif
+
+// The most characters the external scanner may advance over per input byte.
+// A scan that looks ahead for a terminator and fails at every position is
+// what pushes an input over this limit.
+#ifndef TREE_SITTER_BASH_MAX_SCAN_RATIO
+#define TREE_SITTER_BASH_MAX_SCAN_RATIO 32
+#endif
+
+// The scan limit is applied to the input length plus this many bytes, so
+// that short inputs, which the fuzzer mostly produces, aren't judged by a
+// ratio that fixed costs dominate.
+#ifndef TREE_SITTER_BASH_LINEAR_SLACK
+#define TREE_SITTER_BASH_LINEAR_SLACK 1024
+#endif
+
+// How many times the fuzzer times the parses of an input over the limit,
+// keeping the fastest run, which is the one least disturbed by the rest of the
+// machine. The regression suite takes the count from -r instead.
+#ifndef TREE_SITTER_BASH_TIMING_RUNS
+#define TREE_SITTER_BASH_TIMING_RUNS 3
+#endif
+
+typedef struct {
+    uint64_t scanned;
+    double seconds;
+    // The token whose scans advanced over the most characters.
+    unsigned worst_token;
+    uint64_t worst_token_scanned;
+    // The time it took to parse the input repeated twice.
+    double doubled_seconds;
+} Measurement;
+
+static TSParser *parser;
+
+static double fastest_parse(const char *input, uint32_t length, unsigned runs) {
+    double fastest = 0;
+    for (unsigned r = 0; r < runs; r++) {
+        double start = now();
+        TSTree *tree = ts_parser_parse_string(parser, NULL, input, length);
+        double elapsed = now() - start;
+        ts_tree_delete(tree);
+        if (r == 0 || elapsed < fastest) {
+            fastest = elapsed;
+        }
+    }
+    return fastest;
+}
+
+static Measurement measure(const char *input, uint32_t length) {
+    if (!parser) {
+        parser = ts_parser_new();
+        ts_parser_set_language(parser, tree_sitter_bash());
+    }
+
+    TSBashScannerStats stats = {0};
+    tree_sitter_bash_external_scanner_collect_stats(&stats);
+    TSTree *tree = ts_parser_parse_string(parser, NULL, input, length);
+    tree_sitter_bash_external_scanner_collect_stats(NULL);
+    ts_tree_delete(tree);
+
+    Measurement result = {0};
+    for (unsigned i = 0; i < TREE_SITTER_BASH_EXTERNAL_TOKEN_COUNT; i++) {
+        result.scanned += stats.tokens[i].consumed;
+        if (stats.tokens[i].consumed > result.worst_token_scanned) {
+            result.worst_token = i;
+            result.worst_token_scanned = stats.tokens[i].consumed;
+        }
+    }
+    return result;
+}
+
+static void time_parses(Measurement *measurement, const char *input, uint32_t length, unsigned runs) {
+    measurement->seconds = fastest_parse(input, length, runs);
+    char *doubled = malloc((size_t)length * 2 + 1);
+    memcpy(doubled, input, length);
+    memcpy(&doubled[length], input, length);
+    measurement->doubled_seconds = fastest_parse(doubled, length * 2, runs);
+    free(doubled);
+}
+
+static double scan_ratio(const Measurement *measurement, uint32_t length) {
+    return (double)measurement->scanned / (double)(length + TREE_SITTER_BASH_LINEAR_SLACK);
+}
+
+static double ns_per_byte(const Measurement *measurement, uint32_t length) {
+    return length ? measurement->seconds * 1e9 / (double)length : 0;
+}
+
+static double time_growth(const Measurement *measurement) {
+    return measurement->seconds > 0 ? measurement->doubled_seconds / measurement->seconds : 0;
+}
+
+static bool is_super_linear(const Measurement *measurement, uint32_t length) {
+    return scan_ratio(measurement, length) > TREE_SITTER_BASH_MAX_SCAN_RATIO;
+}
+
+#ifdef TREE_SITTER_BASH_LIBFUZZER
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size > UINT32_MAX / 2) {
+        return 0;
+    }
+    uint32_t length = (uint32_t)size;
+    Measurement measurement = measure((const char *)data, length);
+    if (is_super_linear(&measurement, length)) {
+        // Only timed for the report, so that the inputs that pass cost a
+        // single parse.
+        time_parses(&measurement, (const char *)data, length, TREE_SITTER_BASH_TIMING_RUNS);
+        fprintf(stderr,
+                "linear: %u bytes: scanner advanced %llu characters (%.1f per byte, mostly %s), "
+                "parse took %.0f ns per byte, %.1f times as long for twice the input\n",
+                length, (unsigned long long)measurement.scanned, scan_ratio(&measurement, length),
+                tree_sitter_bash_external_scanner_token_name(measurement.worst_token),
+                ns_per_byte(&measurement, length), time_growth(&measurement));
+        abort();
+    }
+    return 0;
+}
+
+#else
+
+static SourceFiles files;
+
+int main(int argc, char **argv) {
+    unsigned repeat = 3;
+    int first_path = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-r") == 0) {
+        repeat = (unsigned)strtoul(argv[2], NULL, 10);
+        repeat = repeat ? repeat : 1;
+        first_path = 3;
+    }
+
+    if (first_path >= argc) {
+        if (!add_sources(&files, "test/lookahead", false)) {
+            return 1;
+        }
+        if (access("test/fuzz/regressions", F_OK) == 0 &&
+            !add_sources(&files, "test/fuzz/regressions", false)) {
+            return 1;
+        }
+    }
+    for (int i = first_path; i < argc; i++) {
+        if (!add_sources(&files, argv[i], false)) {
+            return 1;
+        }
+    }
+
+    if (files.size == 0) {
+        fprintf(stderr, "linear: no input files\n");
+        return 1;
+    }
+
+    size_t failures = 0;
+
+    printf("{\n");
+    printf("  \"max_scan_ratio\": %d,\n", TREE_SITTER_BASH_MAX_SCAN_RATIO);
+    printf("  \"inputs\": [\n");
+    for (size_t i = 0; i < files.size; i++) {
+        SourceFile *file = &files.contents[i];
+
+        Measurement measurement = measure(file->contents, file->length);
+        time_parses(&measurement, file->contents, file->length, repeat);
+        bool failed = is_super_linear(&measurement, file->length);
+        failures += failed;
+
+        printf("    {\n");
+        printf("      \"path\": \"%s\",\n", file->path);
+        printf("      \"bytes\": %u,\n", file->length);
+        printf("      \"scanned\": %llu,\n", (unsigned long long)measurement.scanned);
+        printf("      \"scan_ratio\": %.2f,\n", scan_ratio(&measurement, file->length));
+        printf("      \"worst_token\": \"%s\",\n",
+               tree_sitter_bash_external_scanner_token_name(measurement.worst_token));
+        printf("      \"ns_per_byte\": %.1f,\n", ns_per_byte(&measurement, file->length));
+        printf("      \"time_growth\": %.2f,\n", time_growth(&measurement));
+        printf("      \"super_linear\": %s\n", failed ? "true" : "false");
+        printf("    }%s\n", i + 1 < files.size ? "," : "");
+    }
+    printf("  ],\n");
+    printf("  \"failures\": %zu\n", failures);
+    printf("}\n");
+
+    ts_parser_delete(parser);
+    delete_sources(&files);
+    return failures ? 1 : 0;
+}
+
+#endif
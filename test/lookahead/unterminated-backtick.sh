@@ -0,0 +1,656 @@
+`echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
+echo no closing backtick
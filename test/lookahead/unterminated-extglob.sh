@@ -0,0 +1,2 @@
+case $x in
+@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar@(foo|bar
\ No newline at end of file
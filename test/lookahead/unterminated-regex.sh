@@ -0,0 +1,910 @@
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar
+[[ $x =~ (foo|bar